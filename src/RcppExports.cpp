@@ -330,6 +330,28 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// calc_grm_ibs
+List calc_grm_ibs(const IntegerMatrix& geno);
+RcppExport SEXP _qtl2_calc_grm_ibs(SEXP genoSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const IntegerMatrix& >::type geno(genoSEXP);
+    rcpp_result_gen = Rcpp::wrap(calc_grm_ibs(geno));
+    return rcpp_result_gen;
+END_RCPP
+}
+// calc_grm_std
+List calc_grm_std(const IntegerMatrix& geno);
+RcppExport SEXP _qtl2_calc_grm_std(SEXP genoSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const IntegerMatrix& >::type geno(genoSEXP);
+    rcpp_result_gen = Rcpp::wrap(calc_grm_std(geno));
+    return rcpp_result_gen;
+END_RCPP
+}
 // calc_kinship
 NumericMatrix calc_kinship(const NumericVector& prob_array);
 RcppExport SEXP _qtl2_calc_kinship(SEXP prob_arraySEXP) {
@@ -367,6 +389,22 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// find_invalid_genotypes
+List find_invalid_genotypes(const String& crosstype, const IntegerMatrix& genotypes, const bool is_X_chr, const LogicalVector& is_female, const IntegerMatrix& cross_info, const int max_cells);
+RcppExport SEXP _qtl2_find_invalid_genotypes(SEXP crosstypeSEXP, SEXP genotypesSEXP, SEXP is_X_chrSEXP, SEXP is_femaleSEXP, SEXP cross_infoSEXP, SEXP max_cellsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const String& >::type crosstype(crosstypeSEXP);
+    Rcpp::traits::input_parameter< const IntegerMatrix& >::type genotypes(genotypesSEXP);
+    Rcpp::traits::input_parameter< const bool >::type is_X_chr(is_X_chrSEXP);
+    Rcpp::traits::input_parameter< const LogicalVector& >::type is_female(is_femaleSEXP);
+    Rcpp::traits::input_parameter< const IntegerMatrix& >::type cross_info(cross_infoSEXP);
+    Rcpp::traits::input_parameter< const int >::type max_cells(max_cellsSEXP);
+    rcpp_result_gen = Rcpp::wrap(find_invalid_genotypes(crosstype, genotypes, is_X_chr, is_female, cross_info, max_cells));
+    return rcpp_result_gen;
+END_RCPP
+}
 // check_crossinfo
 bool check_crossinfo(const String& crosstype, const IntegerMatrix& cross_info, const bool any_x_chr);
 RcppExport SEXP _qtl2_check_crossinfo(SEXP crosstypeSEXP, SEXP cross_infoSEXP, SEXP any_x_chrSEXP) {
@@ -440,6 +478,18 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// find_equiv_positions
+IntegerVector find_equiv_positions(const NumericVector& prob_array, const double tol);
+RcppExport SEXP _qtl2_find_equiv_positions(SEXP prob_arraySEXP, SEXP tolSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const NumericVector& >::type prob_array(prob_arraySEXP);
+    Rcpp::traits::input_parameter< const double >::type tol(tolSEXP);
+    rcpp_result_gen = Rcpp::wrap(find_equiv_positions(prob_array, tol));
+    return rcpp_result_gen;
+END_RCPP
+}
 // count_xo
 IntegerVector count_xo(const IntegerMatrix geno, const String& crosstype, const bool is_X_chr);
 RcppExport SEXP _qtl2_count_xo(SEXP genoSEXP, SEXP crosstypeSEXP, SEXP is_X_chrSEXP) {
@@ -540,6 +590,58 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// est_rf
+List est_rf(const String& crosstype, const IntegerMatrix& genotypes, const IntegerMatrix& founder_geno, const bool is_X_chr, const LogicalVector& is_female, const IntegerMatrix& cross_info, const IntegerVector& cross_group, const IntegerVector& unique_cross_group, const IntegerVector& markerA, const IntegerVector& markerB, const NumericVector& pos, const double max_dist, const double min_lod, const bool sparse, const double error_prob, const double tol);
+RcppExport SEXP _qtl2_est_rf(SEXP crosstypeSEXP, SEXP genotypesSEXP, SEXP founder_genoSEXP, SEXP is_X_chrSEXP, SEXP is_femaleSEXP, SEXP cross_infoSEXP, SEXP cross_groupSEXP, SEXP unique_cross_groupSEXP, SEXP markerASEXP, SEXP markerBSEXP, SEXP posSEXP, SEXP max_distSEXP, SEXP min_lodSEXP, SEXP sparseSEXP, SEXP error_probSEXP, SEXP tolSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const String& >::type crosstype(crosstypeSEXP);
+    Rcpp::traits::input_parameter< const IntegerMatrix& >::type genotypes(genotypesSEXP);
+    Rcpp::traits::input_parameter< const IntegerMatrix& >::type founder_geno(founder_genoSEXP);
+    Rcpp::traits::input_parameter< const bool >::type is_X_chr(is_X_chrSEXP);
+    Rcpp::traits::input_parameter< const LogicalVector& >::type is_female(is_femaleSEXP);
+    Rcpp::traits::input_parameter< const IntegerMatrix& >::type cross_info(cross_infoSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type cross_group(cross_groupSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type unique_cross_group(unique_cross_groupSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type markerA(markerASEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type markerB(markerBSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type pos(posSEXP);
+    Rcpp::traits::input_parameter< const double >::type max_dist(max_distSEXP);
+    Rcpp::traits::input_parameter< const double >::type min_lod(min_lodSEXP);
+    Rcpp::traits::input_parameter< const bool >::type sparse(sparseSEXP);
+    Rcpp::traits::input_parameter< const double >::type error_prob(error_probSEXP);
+    Rcpp::traits::input_parameter< const double >::type tol(tolSEXP);
+    rcpp_result_gen = Rcpp::wrap(est_rf(crosstype, genotypes, founder_geno, is_X_chr, is_female, cross_info, cross_group, unique_cross_group, markerA, markerB, pos, max_dist, min_lod, sparse, error_prob, tol));
+    return rcpp_result_gen;
+END_RCPP
+}
+// find_dup_markers
+IntegerVector find_dup_markers(const IntegerMatrix& genotypes, const IntegerMatrix& founder_geno, const bool exact_only, const bool adjacent_only);
+RcppExport SEXP _qtl2_find_dup_markers(SEXP genotypesSEXP, SEXP founder_genoSEXP, SEXP exact_onlySEXP, SEXP adjacent_onlySEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const IntegerMatrix& >::type genotypes(genotypesSEXP);
+    Rcpp::traits::input_parameter< const IntegerMatrix& >::type founder_geno(founder_genoSEXP);
+    Rcpp::traits::input_parameter< const bool >::type exact_only(exact_onlySEXP);
+    Rcpp::traits::input_parameter< const bool >::type adjacent_only(adjacent_onlySEXP);
+    rcpp_result_gen = Rcpp::wrap(find_dup_markers(genotypes, founder_geno, exact_only, adjacent_only));
+    return rcpp_result_gen;
+END_RCPP
+}
+// find_noninf_markers
+IntegerVector find_noninf_markers(const IntegerMatrix& genotypes, const IntegerMatrix& founder_geno);
+RcppExport SEXP _qtl2_find_noninf_markers(SEXP genotypesSEXP, SEXP founder_genoSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const IntegerMatrix& >::type genotypes(genotypesSEXP);
+    Rcpp::traits::input_parameter< const IntegerMatrix& >::type founder_geno(founder_genoSEXP);
+    rcpp_result_gen = Rcpp::wrap(find_noninf_markers(genotypes, founder_geno));
+    return rcpp_result_gen;
+END_RCPP
+}
 // find_ibd_segments
 NumericMatrix find_ibd_segments(const IntegerVector& g1, const IntegerVector& g2, const NumericVector& p, const double error_prob);
 RcppExport SEXP _qtl2_find_ibd_segments(SEXP g1SEXP, SEXP g2SEXP, SEXP pSEXP, SEXP error_probSEXP) {
@@ -703,6 +805,22 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// gblup_cv_pred
+NumericMatrix gblup_cv_pred(const NumericVector& Kva, const NumericMatrix& Kve, const NumericMatrix& Y, const NumericMatrix& X, const double hsq, const IntegerVector& fold);
+RcppExport SEXP _qtl2_gblup_cv_pred(SEXP KvaSEXP, SEXP KveSEXP, SEXP YSEXP, SEXP XSEXP, SEXP hsqSEXP, SEXP foldSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const NumericVector& >::type Kva(KvaSEXP);
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type Kve(KveSEXP);
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type Y(YSEXP);
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type X(XSEXP);
+    Rcpp::traits::input_parameter< const double >::type hsq(hsqSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type fold(foldSEXP);
+    rcpp_result_gen = Rcpp::wrap(gblup_cv_pred(Kva, Kve, Y, X, hsq, fold));
+    return rcpp_result_gen;
+END_RCPP
+}
 // geno_names
 std::vector<std::string> geno_names(const String& crosstype, const std::vector<std::string> alleles, const bool is_x_chr);
 RcppExport SEXP _qtl2_geno_names(SEXP crosstypeSEXP, SEXP allelesSEXP, SEXP is_x_chrSEXP) {
@@ -727,6 +845,72 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// encode_geno_segments
+IntegerMatrix encode_geno_segments(const IntegerMatrix& geno);
+RcppExport SEXP _qtl2_encode_geno_segments(SEXP genoSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const IntegerMatrix& >::type geno(genoSEXP);
+    rcpp_result_gen = Rcpp::wrap(encode_geno_segments(geno));
+    return rcpp_result_gen;
+END_RCPP
+}
+// decode_geno_segments
+IntegerMatrix decode_geno_segments(const IntegerVector& ind, const NumericVector& start, const NumericVector& end, const IntegerVector& geno, const int n_ind, const NumericVector& pos);
+RcppExport SEXP _qtl2_decode_geno_segments(SEXP indSEXP, SEXP startSEXP, SEXP endSEXP, SEXP genoSEXP, SEXP n_indSEXP, SEXP posSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const IntegerVector& >::type ind(indSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type start(startSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type end(endSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type geno(genoSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_ind(n_indSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type pos(posSEXP);
+    rcpp_result_gen = Rcpp::wrap(decode_geno_segments(ind, start, end, geno, n_ind, pos));
+    return rcpp_result_gen;
+END_RCPP
+}
+// decode_geno_segments_alleleprob
+NumericVector decode_geno_segments_alleleprob(const String& crosstype, const IntegerVector& ind, const NumericVector& start, const NumericVector& end, const IntegerVector& geno, const int n_ind, const NumericVector& pos, const int n_gen, const bool is_x_chr);
+RcppExport SEXP _qtl2_decode_geno_segments_alleleprob(SEXP crosstypeSEXP, SEXP indSEXP, SEXP startSEXP, SEXP endSEXP, SEXP genoSEXP, SEXP n_indSEXP, SEXP posSEXP, SEXP n_genSEXP, SEXP is_x_chrSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const String& >::type crosstype(crosstypeSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type ind(indSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type start(startSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type end(endSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type geno(genoSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_ind(n_indSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type pos(posSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_gen(n_genSEXP);
+    Rcpp::traits::input_parameter< const bool >::type is_x_chr(is_x_chrSEXP);
+    rcpp_result_gen = Rcpp::wrap(decode_geno_segments_alleleprob(crosstype, ind, start, end, geno, n_ind, pos, n_gen, is_x_chr));
+    return rcpp_result_gen;
+END_RCPP
+}
+// calc_kinship_segments
+NumericMatrix calc_kinship_segments(const String& crosstype, const IntegerVector& ind, const NumericVector& start, const NumericVector& end, const IntegerVector& geno, const int n_ind, const NumericVector& pos, const int n_gen, const bool is_x_chr, const bool use_allele_probs);
+RcppExport SEXP _qtl2_calc_kinship_segments(SEXP crosstypeSEXP, SEXP indSEXP, SEXP startSEXP, SEXP endSEXP, SEXP genoSEXP, SEXP n_indSEXP, SEXP posSEXP, SEXP n_genSEXP, SEXP is_x_chrSEXP, SEXP use_allele_probsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const String& >::type crosstype(crosstypeSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type ind(indSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type start(startSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type end(endSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type geno(genoSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_ind(n_indSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type pos(posSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_gen(n_genSEXP);
+    Rcpp::traits::input_parameter< const bool >::type is_x_chr(is_x_chrSEXP);
+    Rcpp::traits::input_parameter< const bool >::type use_allele_probs(use_allele_probsSEXP);
+    rcpp_result_gen = Rcpp::wrap(calc_kinship_segments(crosstype, ind, start, end, geno, n_ind, pos, n_gen, is_x_chr, use_allele_probs));
+    return rcpp_result_gen;
+END_RCPP
+}
 // genoprob_to_alleleprob
 NumericVector genoprob_to_alleleprob(const String& crosstype, const NumericVector& prob_array, const bool is_x_chr);
 RcppExport SEXP _qtl2_genoprob_to_alleleprob(SEXP crosstypeSEXP, SEXP prob_arraySEXP, SEXP is_x_chrSEXP) {
@@ -804,6 +988,21 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// guess_phase_segments
+IntegerMatrix guess_phase_segments(const IntegerVector& geno, const String& crosstype, const bool is_x_chr, const LogicalVector& is_female, const bool deterministic);
+RcppExport SEXP _qtl2_guess_phase_segments(SEXP genoSEXP, SEXP crosstypeSEXP, SEXP is_x_chrSEXP, SEXP is_femaleSEXP, SEXP deterministicSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const IntegerVector& >::type geno(genoSEXP);
+    Rcpp::traits::input_parameter< const String& >::type crosstype(crosstypeSEXP);
+    Rcpp::traits::input_parameter< const bool >::type is_x_chr(is_x_chrSEXP);
+    Rcpp::traits::input_parameter< const LogicalVector& >::type is_female(is_femaleSEXP);
+    Rcpp::traits::input_parameter< const bool >::type deterministic(deterministicSEXP);
+    rcpp_result_gen = Rcpp::wrap(guess_phase_segments(geno, crosstype, is_x_chr, is_female, deterministic));
+    return rcpp_result_gen;
+END_RCPP
+}
 // calc_errorlod
 NumericMatrix calc_errorlod(const String& crosstype, const NumericVector& probs, const IntegerMatrix& genotypes, const IntegerMatrix& founder_geno, const bool is_X_chr, const bool is_female, const IntegerVector& cross_info);
 RcppExport SEXP _qtl2_calc_errorlod(SEXP crosstypeSEXP, SEXP probsSEXP, SEXP genotypesSEXP, SEXP founder_genoSEXP, SEXP is_X_chrSEXP, SEXP is_femaleSEXP, SEXP cross_infoSEXP) {
@@ -822,8 +1021,8 @@ BEGIN_RCPP
 END_RCPP
 }
 // calc_genoprob
-NumericVector calc_genoprob(const String& crosstype, const IntegerMatrix& genotypes, const IntegerMatrix& founder_geno, const bool is_X_chr, const LogicalVector& is_female, const IntegerMatrix& cross_info, const NumericVector& rec_frac, const IntegerVector& marker_index, const double error_prob);
-RcppExport SEXP _qtl2_calc_genoprob(SEXP crosstypeSEXP, SEXP genotypesSEXP, SEXP founder_genoSEXP, SEXP is_X_chrSEXP, SEXP is_femaleSEXP, SEXP cross_infoSEXP, SEXP rec_fracSEXP, SEXP marker_indexSEXP, SEXP error_probSEXP) {
+NumericVector calc_genoprob(const String& crosstype, const IntegerMatrix& genotypes, const IntegerMatrix& founder_geno, const bool is_X_chr, const LogicalVector& is_female, const IntegerMatrix& cross_info, const NumericVector& rec_frac, const IntegerVector& marker_index, const double error_prob, const IntegerVector& out_index);
+RcppExport SEXP _qtl2_calc_genoprob(SEXP crosstypeSEXP, SEXP genotypesSEXP, SEXP founder_genoSEXP, SEXP is_X_chrSEXP, SEXP is_femaleSEXP, SEXP cross_infoSEXP, SEXP rec_fracSEXP, SEXP marker_indexSEXP, SEXP error_probSEXP, SEXP out_indexSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -836,13 +1035,34 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const NumericVector& >::type rec_frac(rec_fracSEXP);
     Rcpp::traits::input_parameter< const IntegerVector& >::type marker_index(marker_indexSEXP);
     Rcpp::traits::input_parameter< const double >::type error_prob(error_probSEXP);
-    rcpp_result_gen = Rcpp::wrap(calc_genoprob(crosstype, genotypes, founder_geno, is_X_chr, is_female, cross_info, rec_frac, marker_index, error_prob));
+    Rcpp::traits::input_parameter< const IntegerVector& >::type out_index(out_indexSEXP);
+    rcpp_result_gen = Rcpp::wrap(calc_genoprob(crosstype, genotypes, founder_geno, is_X_chr, is_female, cross_info, rec_frac, marker_index, error_prob, out_index));
     return rcpp_result_gen;
 END_RCPP
 }
 // calc_genoprob2
-NumericVector calc_genoprob2(const String& crosstype, const IntegerMatrix& genotypes, const IntegerMatrix& founder_geno, const bool is_X_chr, const bool is_female, const IntegerVector& cross_info, const NumericVector& rec_frac, const IntegerVector& marker_index, const double error_prob);
-RcppExport SEXP _qtl2_calc_genoprob2(SEXP crosstypeSEXP, SEXP genotypesSEXP, SEXP founder_genoSEXP, SEXP is_X_chrSEXP, SEXP is_femaleSEXP, SEXP cross_infoSEXP, SEXP rec_fracSEXP, SEXP marker_indexSEXP, SEXP error_probSEXP) {
+NumericVector calc_genoprob2(const String& crosstype, const IntegerMatrix& genotypes, const IntegerMatrix& founder_geno, const bool is_X_chr, const bool is_female, const IntegerVector& cross_info, const NumericVector& rec_frac, const IntegerVector& marker_index, const double error_prob, const IntegerVector& out_index);
+RcppExport SEXP _qtl2_calc_genoprob2(SEXP crosstypeSEXP, SEXP genotypesSEXP, SEXP founder_genoSEXP, SEXP is_X_chrSEXP, SEXP is_femaleSEXP, SEXP cross_infoSEXP, SEXP rec_fracSEXP, SEXP marker_indexSEXP, SEXP error_probSEXP, SEXP out_indexSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const String& >::type crosstype(crosstypeSEXP);
+    Rcpp::traits::input_parameter< const IntegerMatrix& >::type genotypes(genotypesSEXP);
+    Rcpp::traits::input_parameter< const IntegerMatrix& >::type founder_geno(founder_genoSEXP);
+    Rcpp::traits::input_parameter< const bool >::type is_X_chr(is_X_chrSEXP);
+    Rcpp::traits::input_parameter< const bool >::type is_female(is_femaleSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type cross_info(cross_infoSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type rec_frac(rec_fracSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type marker_index(marker_indexSEXP);
+    Rcpp::traits::input_parameter< const double >::type error_prob(error_probSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type out_index(out_indexSEXP);
+    rcpp_result_gen = Rcpp::wrap(calc_genoprob2(crosstype, genotypes, founder_geno, is_X_chr, is_female, cross_info, rec_frac, marker_index, error_prob, out_index));
+    return rcpp_result_gen;
+END_RCPP
+}
+// calc_alleleprob2
+NumericVector calc_alleleprob2(const String& crosstype, const IntegerMatrix& genotypes, const IntegerMatrix& founder_geno, const bool is_X_chr, const bool is_female, const IntegerVector& cross_info, const NumericVector& rec_frac, const IntegerVector& marker_index, const double error_prob, const IntegerVector& out_index);
+RcppExport SEXP _qtl2_calc_alleleprob2(SEXP crosstypeSEXP, SEXP genotypesSEXP, SEXP founder_genoSEXP, SEXP is_X_chrSEXP, SEXP is_femaleSEXP, SEXP cross_infoSEXP, SEXP rec_fracSEXP, SEXP marker_indexSEXP, SEXP error_probSEXP, SEXP out_indexSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -855,7 +1075,8 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const NumericVector& >::type rec_frac(rec_fracSEXP);
     Rcpp::traits::input_parameter< const IntegerVector& >::type marker_index(marker_indexSEXP);
     Rcpp::traits::input_parameter< const double >::type error_prob(error_probSEXP);
-    rcpp_result_gen = Rcpp::wrap(calc_genoprob2(crosstype, genotypes, founder_geno, is_X_chr, is_female, cross_info, rec_frac, marker_index, error_prob));
+    Rcpp::traits::input_parameter< const IntegerVector& >::type out_index(out_indexSEXP);
+    rcpp_result_gen = Rcpp::wrap(calc_alleleprob2(crosstype, genotypes, founder_geno, is_X_chr, is_female, cross_info, rec_frac, marker_index, error_prob, out_index));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -1005,6 +1226,52 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// viterbi2_segments
+IntegerMatrix viterbi2_segments(const String& crosstype, const IntegerMatrix& genotypes, const IntegerMatrix& founder_geno, const bool is_X_chr, const bool is_female, const IntegerVector& cross_info, const NumericVector& rec_frac, const IntegerVector& marker_index, const double error_prob);
+RcppExport SEXP _qtl2_viterbi2_segments(SEXP crosstypeSEXP, SEXP genotypesSEXP, SEXP founder_genoSEXP, SEXP is_X_chrSEXP, SEXP is_femaleSEXP, SEXP cross_infoSEXP, SEXP rec_fracSEXP, SEXP marker_indexSEXP, SEXP error_probSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const String& >::type crosstype(crosstypeSEXP);
+    Rcpp::traits::input_parameter< const IntegerMatrix& >::type genotypes(genotypesSEXP);
+    Rcpp::traits::input_parameter< const IntegerMatrix& >::type founder_geno(founder_genoSEXP);
+    Rcpp::traits::input_parameter< const bool >::type is_X_chr(is_X_chrSEXP);
+    Rcpp::traits::input_parameter< const bool >::type is_female(is_femaleSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type cross_info(cross_infoSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type rec_frac(rec_fracSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type marker_index(marker_indexSEXP);
+    Rcpp::traits::input_parameter< const double >::type error_prob(error_probSEXP);
+    rcpp_result_gen = Rcpp::wrap(viterbi2_segments(crosstype, genotypes, founder_geno, is_X_chr, is_female, cross_info, rec_frac, marker_index, error_prob));
+    return rcpp_result_gen;
+END_RCPP
+}
+// index_snps_onechr
+List index_snps_onechr(const NumericVector& pos, const IntegerVector& sdp, const NumericVector& map, const double tol);
+RcppExport SEXP _qtl2_index_snps_onechr(SEXP posSEXP, SEXP sdpSEXP, SEXP mapSEXP, SEXP tolSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const NumericVector& >::type pos(posSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type sdp(sdpSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type map(mapSEXP);
+    Rcpp::traits::input_parameter< const double >::type tol(tolSEXP);
+    rcpp_result_gen = Rcpp::wrap(index_snps_onechr(pos, sdp, map, tol));
+    return rcpp_result_gen;
+END_RCPP
+}
+// expand_snp_lod
+IntegerVector expand_snp_lod(const IntegerVector& revindex, const NumericVector& lod, const double drop);
+RcppExport SEXP _qtl2_expand_snp_lod(SEXP revindexSEXP, SEXP lodSEXP, SEXP dropSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const IntegerVector& >::type revindex(revindexSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type lod(lodSEXP);
+    Rcpp::traits::input_parameter< const double >::type drop(dropSEXP);
+    rcpp_result_gen = Rcpp::wrap(expand_snp_lod(revindex, lod, drop));
+    return rcpp_result_gen;
+END_RCPP
+}
 // interp_genoprob_onechr
 NumericVector interp_genoprob_onechr(const NumericVector& genoprob, const NumericVector& map, const IntegerVector& pos_index);
 RcppExport SEXP _qtl2_interp_genoprob_onechr(SEXP genoprobSEXP, SEXP mapSEXP, SEXP pos_indexSEXP) {
@@ -1044,6 +1311,34 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// points_in_interval
+IntegerVector points_in_interval(const NumericVector& pos, const double start, const double end);
+RcppExport SEXP _qtl2_points_in_interval(SEXP posSEXP, SEXP startSEXP, SEXP endSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const NumericVector& >::type pos(posSEXP);
+    Rcpp::traits::input_parameter< const double >::type start(startSEXP);
+    Rcpp::traits::input_parameter< const double >::type end(endSEXP);
+    rcpp_result_gen = Rcpp::wrap(points_in_interval(pos, start, end));
+    return rcpp_result_gen;
+END_RCPP
+}
+// intervals_overlapping
+IntegerVector intervals_overlapping(const NumericVector& start, const NumericVector& stop, const NumericVector& stop_cummax, const double qstart, const double qend);
+RcppExport SEXP _qtl2_intervals_overlapping(SEXP startSEXP, SEXP stopSEXP, SEXP stop_cummaxSEXP, SEXP qstartSEXP, SEXP qendSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const NumericVector& >::type start(startSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type stop(stopSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type stop_cummax(stop_cummaxSEXP);
+    Rcpp::traits::input_parameter< const double >::type qstart(qstartSEXP);
+    Rcpp::traits::input_parameter< const double >::type qend(qendSEXP);
+    rcpp_result_gen = Rcpp::wrap(intervals_overlapping(start, stop, stop_cummax, qstart, qend));
+    return rcpp_result_gen;
+END_RCPP
+}
 // calc_rss_linreg
 NumericVector calc_rss_linreg(const NumericMatrix& X, const NumericMatrix& Y, const double tol);
 RcppExport SEXP _qtl2_calc_rss_linreg(SEXP XSEXP, SEXP YSEXP, SEXP tolSEXP) {
@@ -1385,6 +1680,45 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// fit_lmm_binary_pql
+List fit_lmm_binary_pql(const NumericMatrix& K, const NumericVector& y, const NumericMatrix& X, const bool reml, const int maxit, const double bintol, const double tol, const double eta_max);
+RcppExport SEXP _qtl2_fit_lmm_binary_pql(SEXP KSEXP, SEXP ySEXP, SEXP XSEXP, SEXP remlSEXP, SEXP maxitSEXP, SEXP bintolSEXP, SEXP tolSEXP, SEXP eta_maxSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type K(KSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type y(ySEXP);
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type X(XSEXP);
+    Rcpp::traits::input_parameter< const bool >::type reml(remlSEXP);
+    Rcpp::traits::input_parameter< const int >::type maxit(maxitSEXP);
+    Rcpp::traits::input_parameter< const double >::type bintol(bintolSEXP);
+    Rcpp::traits::input_parameter< const double >::type tol(tolSEXP);
+    Rcpp::traits::input_parameter< const double >::type eta_max(eta_maxSEXP);
+    rcpp_result_gen = Rcpp::wrap(fit_lmm_binary_pql(K, y, X, reml, maxit, bintol, tol, eta_max));
+    return rcpp_result_gen;
+END_RCPP
+}
+// fit_lmm_binary_pql_start
+List fit_lmm_binary_pql_start(const NumericMatrix& K, const NumericVector& y, const NumericMatrix& X, const NumericVector& eta, const NumericVector& Kva, const NumericMatrix& Kve, const bool reml, const int maxit, const double bintol, const double tol, const double eta_max);
+RcppExport SEXP _qtl2_fit_lmm_binary_pql_start(SEXP KSEXP, SEXP ySEXP, SEXP XSEXP, SEXP etaSEXP, SEXP KvaSEXP, SEXP KveSEXP, SEXP remlSEXP, SEXP maxitSEXP, SEXP bintolSEXP, SEXP tolSEXP, SEXP eta_maxSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type K(KSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type y(ySEXP);
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type X(XSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type eta(etaSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type Kva(KvaSEXP);
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type Kve(KveSEXP);
+    Rcpp::traits::input_parameter< const bool >::type reml(remlSEXP);
+    Rcpp::traits::input_parameter< const int >::type maxit(maxitSEXP);
+    Rcpp::traits::input_parameter< const double >::type bintol(bintolSEXP);
+    Rcpp::traits::input_parameter< const double >::type tol(tolSEXP);
+    Rcpp::traits::input_parameter< const double >::type eta_max(eta_maxSEXP);
+    rcpp_result_gen = Rcpp::wrap(fit_lmm_binary_pql_start(K, y, X, eta, Kva, Kve, reml, maxit, bintol, tol, eta_max));
+    return rcpp_result_gen;
+END_RCPP
+}
 // locate_xo
 List locate_xo(const IntegerMatrix geno, const NumericVector map, const String& crosstype, const bool is_X_chr);
 RcppExport SEXP _qtl2_locate_xo(SEXP genoSEXP, SEXP mapSEXP, SEXP crosstypeSEXP, SEXP is_X_chrSEXP) {
@@ -1535,16 +1869,79 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// linkage_groups
+IntegerVector linkage_groups(const int n_mar, const IntegerVector& marker1, const IntegerVector& marker2);
+RcppExport SEXP _qtl2_linkage_groups(SEXP n_marSEXP, SEXP marker1SEXP, SEXP marker2SEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const int >::type n_mar(n_marSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type marker1(marker1SEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type marker2(marker2SEXP);
+    rcpp_result_gen = Rcpp::wrap(linkage_groups(n_mar, marker1, marker2));
+    return rcpp_result_gen;
+END_RCPP
+}
+// order_tsp
+IntegerVector order_tsp(const NumericMatrix& dist, const int n_start);
+RcppExport SEXP _qtl2_order_tsp(SEXP distSEXP, SEXP n_startSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type dist(distSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_start(n_startSEXP);
+    rcpp_result_gen = Rcpp::wrap(order_tsp(dist, n_start));
+    return rcpp_result_gen;
+END_RCPP
+}
+// path_length
+double path_length(const NumericMatrix& dist, const IntegerVector& order);
+RcppExport SEXP _qtl2_path_length(SEXP distSEXP, SEXP orderSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type dist(distSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type order(orderSEXP);
+    rcpp_result_gen = Rcpp::wrap(path_length(dist, order));
+    return rcpp_result_gen;
+END_RCPP
+}
+// parse_vcf_lines
+List parse_vcf_lines(const CharacterVector& lines, const IntegerVector& sample_index, const int ref_pos, const bool require_fi);
+RcppExport SEXP _qtl2_parse_vcf_lines(SEXP linesSEXP, SEXP sample_indexSEXP, SEXP ref_posSEXP, SEXP require_fiSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const CharacterVector& >::type lines(linesSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type sample_index(sample_indexSEXP);
+    Rcpp::traits::input_parameter< const int >::type ref_pos(ref_posSEXP);
+    Rcpp::traits::input_parameter< const bool >::type require_fi(require_fiSEXP);
+    rcpp_result_gen = Rcpp::wrap(parse_vcf_lines(lines, sample_index, ref_pos, require_fi));
+    return rcpp_result_gen;
+END_RCPP
+}
 // predict_snpgeno
-IntegerMatrix predict_snpgeno(const IntegerMatrix& allele1, const IntegerMatrix& allele2, const IntegerMatrix& founder_geno);
-RcppExport SEXP _qtl2_predict_snpgeno(SEXP allele1SEXP, SEXP allele2SEXP, SEXP founder_genoSEXP) {
+IntegerMatrix predict_snpgeno(const IntegerVector& phase, const IntegerMatrix& founder_geno, const LogicalVector& hemizygous);
+RcppExport SEXP _qtl2_predict_snpgeno(SEXP phaseSEXP, SEXP founder_genoSEXP, SEXP hemizygousSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< const IntegerMatrix& >::type allele1(allele1SEXP);
-    Rcpp::traits::input_parameter< const IntegerMatrix& >::type allele2(allele2SEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type phase(phaseSEXP);
     Rcpp::traits::input_parameter< const IntegerMatrix& >::type founder_geno(founder_genoSEXP);
-    rcpp_result_gen = Rcpp::wrap(predict_snpgeno(allele1, allele2, founder_geno));
+    Rcpp::traits::input_parameter< const LogicalVector& >::type hemizygous(hemizygousSEXP);
+    rcpp_result_gen = Rcpp::wrap(predict_snpgeno(phase, founder_geno, hemizygous));
+    return rcpp_result_gen;
+END_RCPP
+}
+// predict_snpdosage
+NumericMatrix predict_snpdosage(const NumericVector& alleleprob, const IntegerMatrix& founder_geno);
+RcppExport SEXP _qtl2_predict_snpdosage(SEXP alleleprobSEXP, SEXP founder_genoSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const NumericVector& >::type alleleprob(alleleprobSEXP);
+    Rcpp::traits::input_parameter< const IntegerMatrix& >::type founder_geno(founder_genoSEXP);
+    rcpp_result_gen = Rcpp::wrap(predict_snpdosage(alleleprob, founder_geno));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -1848,6 +2245,19 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// scan_hk_onechr_multi
+NumericVector scan_hk_onechr_multi(const NumericVector& genoprobs, const NumericMatrix& pheno, const double tol);
+RcppExport SEXP _qtl2_scan_hk_onechr_multi(SEXP genoprobsSEXP, SEXP phenoSEXP, SEXP tolSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const NumericVector& >::type genoprobs(genoprobsSEXP);
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type pheno(phenoSEXP);
+    Rcpp::traits::input_parameter< const double >::type tol(tolSEXP);
+    rcpp_result_gen = Rcpp::wrap(scan_hk_onechr_multi(genoprobs, pheno, tol));
+    return rcpp_result_gen;
+END_RCPP
+}
 // scan_pg_onechr
 NumericVector scan_pg_onechr(const NumericVector& genoprobs, const NumericMatrix& pheno, const NumericMatrix& addcovar, const NumericMatrix& eigenvec, const NumericVector& weights, const double tol);
 RcppExport SEXP _qtl2_scan_pg_onechr(SEXP genoprobsSEXP, SEXP phenoSEXP, SEXP addcovarSEXP, SEXP eigenvecSEXP, SEXP weightsSEXP, SEXP tolSEXP) {
@@ -1914,6 +2324,21 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// boot_peaks_hk_onechr
+IntegerMatrix boot_peaks_hk_onechr(const NumericVector& genoprobs, const NumericMatrix& pheno, const NumericMatrix& addcovar, const NumericMatrix& boot_weights, const double tol);
+RcppExport SEXP _qtl2_boot_peaks_hk_onechr(SEXP genoprobsSEXP, SEXP phenoSEXP, SEXP addcovarSEXP, SEXP boot_weightsSEXP, SEXP tolSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const NumericVector& >::type genoprobs(genoprobsSEXP);
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type pheno(phenoSEXP);
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type addcovar(addcovarSEXP);
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type boot_weights(boot_weightsSEXP);
+    Rcpp::traits::input_parameter< const double >::type tol(tolSEXP);
+    rcpp_result_gen = Rcpp::wrap(boot_peaks_hk_onechr(genoprobs, pheno, addcovar, boot_weights, tol));
+    return rcpp_result_gen;
+END_RCPP
+}
 // scancoef_binary_addcovar
 NumericMatrix scancoef_binary_addcovar(const NumericVector& genoprobs, const NumericVector& pheno, const NumericMatrix& addcovar, const NumericVector& weights, const int maxit, const double tol, const double qr_tol, const double eta_max);
 RcppExport SEXP _qtl2_scancoef_binary_addcovar(SEXP genoprobsSEXP, SEXP phenoSEXP, SEXP addcovarSEXP, SEXP weightsSEXP, SEXP maxitSEXP, SEXP tolSEXP, SEXP qr_tolSEXP, SEXP eta_maxSEXP) {
@@ -2116,6 +2541,123 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// calc_orthobasis
+NumericMatrix calc_orthobasis(const NumericMatrix& X, const double tol);
+RcppExport SEXP _qtl2_calc_orthobasis(SEXP XSEXP, SEXP tolSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type X(XSEXP);
+    Rcpp::traits::input_parameter< const double >::type tol(tolSEXP);
+    rcpp_result_gen = Rcpp::wrap(calc_orthobasis(X, tol));
+    return rcpp_result_gen;
+END_RCPP
+}
+// project_out_matrix
+NumericMatrix project_out_matrix(const NumericMatrix& U, const NumericMatrix& Y);
+RcppExport SEXP _qtl2_project_out_matrix(SEXP USEXP, SEXP YSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type U(USEXP);
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type Y(YSEXP);
+    rcpp_result_gen = Rcpp::wrap(project_out_matrix(U, Y));
+    return rcpp_result_gen;
+END_RCPP
+}
+// project_out_3darray
+NumericVector project_out_3darray(const NumericMatrix& U, const NumericVector& P, const double tol);
+RcppExport SEXP _qtl2_project_out_3darray(SEXP USEXP, SEXP PSEXP, SEXP tolSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type U(USEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type P(PSEXP);
+    Rcpp::traits::input_parameter< const double >::type tol(tolSEXP);
+    rcpp_result_gen = Rcpp::wrap(project_out_3darray(U, P, tol));
+    return rcpp_result_gen;
+END_RCPP
+}
+// scan_mediators
+NumericMatrix scan_mediators(const NumericMatrix& addcovar, const NumericMatrix& genoprobs, const NumericVector& pheno, const NumericMatrix& mediators, const bool reverse, const double tol);
+RcppExport SEXP _qtl2_scan_mediators(SEXP addcovarSEXP, SEXP genoprobsSEXP, SEXP phenoSEXP, SEXP mediatorsSEXP, SEXP reverseSEXP, SEXP tolSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type addcovar(addcovarSEXP);
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type genoprobs(genoprobsSEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type pheno(phenoSEXP);
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type mediators(mediatorsSEXP);
+    Rcpp::traits::input_parameter< const bool >::type reverse(reverseSEXP);
+    Rcpp::traits::input_parameter< const double >::type tol(tolSEXP);
+    rcpp_result_gen = Rcpp::wrap(scan_mediators(addcovar, genoprobs, pheno, mediators, reverse, tol));
+    return rcpp_result_gen;
+END_RCPP
+}
+// scan_hk_lowrank
+NumericMatrix scan_hk_lowrank(const NumericMatrix& U, const NumericVector& V, const NumericMatrix& pheno, const double tol);
+RcppExport SEXP _qtl2_scan_hk_lowrank(SEXP USEXP, SEXP VSEXP, SEXP phenoSEXP, SEXP tolSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type U(USEXP);
+    Rcpp::traits::input_parameter< const NumericVector& >::type V(VSEXP);
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type pheno(phenoSEXP);
+    Rcpp::traits::input_parameter< const double >::type tol(tolSEXP);
+    rcpp_result_gen = Rcpp::wrap(scan_hk_lowrank(U, V, pheno, tol));
+    return rcpp_result_gen;
+END_RCPP
+}
+// simd_level
+std::string simd_level(const std::string& level);
+RcppExport SEXP _qtl2_simd_level(SEXP levelSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const std::string& >::type level(levelSEXP);
+    rcpp_result_gen = Rcpp::wrap(simd_level(level));
+    return rcpp_result_gen;
+END_RCPP
+}
+// simd_available
+CharacterVector simd_available();
+RcppExport SEXP _qtl2_simd_available() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(simd_available());
+    return rcpp_result_gen;
+END_RCPP
+}
+// genocol_to_dosage
+NumericVector genocol_to_dosage(const int n_str, const int n_gen, const int sdp);
+RcppExport SEXP _qtl2_genocol_to_dosage(SEXP n_strSEXP, SEXP n_genSEXP, SEXP sdpSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const int >::type n_str(n_strSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_gen(n_genSEXP);
+    Rcpp::traits::input_parameter< const int >::type sdp(sdpSEXP);
+    rcpp_result_gen = Rcpp::wrap(genocol_to_dosage(n_str, n_gen, sdp));
+    return rcpp_result_gen;
+END_RCPP
+}
+// snp_dosage_fixedpoint
+IntegerMatrix snp_dosage_fixedpoint(const NumericVector& genoprob, const int n_str, const IntegerVector& sdp, const IntegerVector& interval, const LogicalVector& on_map, const int bits);
+RcppExport SEXP _qtl2_snp_dosage_fixedpoint(SEXP genoprobSEXP, SEXP n_strSEXP, SEXP sdpSEXP, SEXP intervalSEXP, SEXP on_mapSEXP, SEXP bitsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const NumericVector& >::type genoprob(genoprobSEXP);
+    Rcpp::traits::input_parameter< const int >::type n_str(n_strSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type sdp(sdpSEXP);
+    Rcpp::traits::input_parameter< const IntegerVector& >::type interval(intervalSEXP);
+    Rcpp::traits::input_parameter< const LogicalVector& >::type on_map(on_mapSEXP);
+    Rcpp::traits::input_parameter< const int >::type bits(bitsSEXP);
+    rcpp_result_gen = Rcpp::wrap(snp_dosage_fixedpoint(genoprob, n_str, sdp, interval, on_map, bits));
+    return rcpp_result_gen;
+END_RCPP
+}
 // calc_sdp
 IntegerVector calc_sdp(const IntegerMatrix& geno);
 RcppExport SEXP _qtl2_calc_sdp(SEXP genoSEXP) {
@@ -2417,15 +2959,19 @@ static const R_CallMethodDef CallEntries[] = {
     {"_qtl2_calc_coef_binreg_weighted_eigenqr", (DL_FUNC) &_qtl2_calc_coef_binreg_weighted_eigenqr, 7},
     {"_qtl2_calc_coefSE_binreg_weighted_eigenqr", (DL_FUNC) &_qtl2_calc_coefSE_binreg_weighted_eigenqr, 7},
     {"_qtl2_fit_binreg_weighted_eigenqr", (DL_FUNC) &_qtl2_fit_binreg_weighted_eigenqr, 8},
+    {"_qtl2_calc_grm_ibs", (DL_FUNC) &_qtl2_calc_grm_ibs, 1},
+    {"_qtl2_calc_grm_std", (DL_FUNC) &_qtl2_calc_grm_std, 1},
     {"_qtl2_calc_kinship", (DL_FUNC) &_qtl2_calc_kinship, 1},
     {"_qtl2_crosstype_supported", (DL_FUNC) &_qtl2_crosstype_supported, 1},
     {"_qtl2_count_invalid_genotypes", (DL_FUNC) &_qtl2_count_invalid_genotypes, 5},
+    {"_qtl2_find_invalid_genotypes", (DL_FUNC) &_qtl2_find_invalid_genotypes, 6},
     {"_qtl2_check_crossinfo", (DL_FUNC) &_qtl2_check_crossinfo, 3},
     {"_qtl2_check_is_female_vector", (DL_FUNC) &_qtl2_check_is_female_vector, 3},
     {"_qtl2_check_handle_x_chr", (DL_FUNC) &_qtl2_check_handle_x_chr, 2},
     {"_qtl2_chisq_colpairs", (DL_FUNC) &_qtl2_chisq_colpairs, 1},
     {"_qtl2_clean_genoprob", (DL_FUNC) &_qtl2_clean_genoprob, 3},
     {"_qtl2_compare_geno", (DL_FUNC) &_qtl2_compare_geno, 1},
+    {"_qtl2_find_equiv_positions", (DL_FUNC) &_qtl2_find_equiv_positions, 2},
     {"_qtl2_count_xo", (DL_FUNC) &_qtl2_count_xo, 3},
     {"_qtl2_count_xo_3d", (DL_FUNC) &_qtl2_count_xo_3d, 3},
     {"_qtl2_mpp_encode_alleles", (DL_FUNC) &_qtl2_mpp_encode_alleles, 4},
@@ -2434,6 +2980,9 @@ static const R_CallMethodDef CallEntries[] = {
     {"_qtl2_mpp_geno_names", (DL_FUNC) &_qtl2_mpp_geno_names, 2},
     {"_qtl2_invert_founder_index", (DL_FUNC) &_qtl2_invert_founder_index, 1},
     {"_qtl2_is_phase_known", (DL_FUNC) &_qtl2_is_phase_known, 1},
+    {"_qtl2_est_rf", (DL_FUNC) &_qtl2_est_rf, 16},
+    {"_qtl2_find_dup_markers", (DL_FUNC) &_qtl2_find_dup_markers, 4},
+    {"_qtl2_find_noninf_markers", (DL_FUNC) &_qtl2_find_noninf_markers, 2},
     {"_qtl2_find_ibd_segments", (DL_FUNC) &_qtl2_find_ibd_segments, 4},
     {"_qtl2_R_find_peaks", (DL_FUNC) &_qtl2_R_find_peaks, 3},
     {"_qtl2_R_find_peaks_and_lodint", (DL_FUNC) &_qtl2_R_find_peaks_and_lodint, 4},
@@ -2444,17 +2993,24 @@ static const R_CallMethodDef CallEntries[] = {
     {"_qtl2_fit1_hk_intcovar", (DL_FUNC) &_qtl2_fit1_hk_intcovar, 7},
     {"_qtl2_fit1_pg_addcovar", (DL_FUNC) &_qtl2_fit1_pg_addcovar, 7},
     {"_qtl2_fit1_pg_intcovar", (DL_FUNC) &_qtl2_fit1_pg_intcovar, 8},
+    {"_qtl2_gblup_cv_pred", (DL_FUNC) &_qtl2_gblup_cv_pred, 6},
     {"_qtl2_geno_names", (DL_FUNC) &_qtl2_geno_names, 3},
     {"_qtl2_nalleles", (DL_FUNC) &_qtl2_nalleles, 1},
+    {"_qtl2_encode_geno_segments", (DL_FUNC) &_qtl2_encode_geno_segments, 1},
+    {"_qtl2_decode_geno_segments", (DL_FUNC) &_qtl2_decode_geno_segments, 6},
+    {"_qtl2_decode_geno_segments_alleleprob", (DL_FUNC) &_qtl2_decode_geno_segments_alleleprob, 9},
+    {"_qtl2_calc_kinship_segments", (DL_FUNC) &_qtl2_calc_kinship_segments, 10},
     {"_qtl2_genoprob_to_alleleprob", (DL_FUNC) &_qtl2_genoprob_to_alleleprob, 3},
     {"_qtl2_get_x_covar", (DL_FUNC) &_qtl2_get_x_covar, 3},
     {"_qtl2_guess_phase_f2A", (DL_FUNC) &_qtl2_guess_phase_f2A, 2},
     {"_qtl2_guess_phase_f2X", (DL_FUNC) &_qtl2_guess_phase_f2X, 2},
     {"_qtl2_guess_phase_A", (DL_FUNC) &_qtl2_guess_phase_A, 3},
     {"_qtl2_guess_phase_X", (DL_FUNC) &_qtl2_guess_phase_X, 4},
+    {"_qtl2_guess_phase_segments", (DL_FUNC) &_qtl2_guess_phase_segments, 5},
     {"_qtl2_calc_errorlod", (DL_FUNC) &_qtl2_calc_errorlod, 7},
-    {"_qtl2_calc_genoprob", (DL_FUNC) &_qtl2_calc_genoprob, 9},
-    {"_qtl2_calc_genoprob2", (DL_FUNC) &_qtl2_calc_genoprob2, 9},
+    {"_qtl2_calc_genoprob", (DL_FUNC) &_qtl2_calc_genoprob, 10},
+    {"_qtl2_calc_genoprob2", (DL_FUNC) &_qtl2_calc_genoprob2, 10},
+    {"_qtl2_calc_alleleprob2", (DL_FUNC) &_qtl2_calc_alleleprob2, 10},
     {"_qtl2_est_map", (DL_FUNC) &_qtl2_est_map, 11},
     {"_qtl2_est_map2", (DL_FUNC) &_qtl2_est_map2, 13},
     {"_qtl2_sim_geno", (DL_FUNC) &_qtl2_sim_geno, 10},
@@ -2463,9 +3019,14 @@ static const R_CallMethodDef CallEntries[] = {
     {"_qtl2_subtractlog", (DL_FUNC) &_qtl2_subtractlog, 2},
     {"_qtl2_viterbi", (DL_FUNC) &_qtl2_viterbi, 9},
     {"_qtl2_viterbi2", (DL_FUNC) &_qtl2_viterbi2, 9},
+    {"_qtl2_viterbi2_segments", (DL_FUNC) &_qtl2_viterbi2_segments, 9},
+    {"_qtl2_index_snps_onechr", (DL_FUNC) &_qtl2_index_snps_onechr, 4},
+    {"_qtl2_expand_snp_lod", (DL_FUNC) &_qtl2_expand_snp_lod, 3},
     {"_qtl2_interp_genoprob_onechr", (DL_FUNC) &_qtl2_interp_genoprob_onechr, 3},
     {"_qtl2_interpolate_map", (DL_FUNC) &_qtl2_interpolate_map, 3},
     {"_qtl2_find_intervals", (DL_FUNC) &_qtl2_find_intervals, 3},
+    {"_qtl2_points_in_interval", (DL_FUNC) &_qtl2_points_in_interval, 3},
+    {"_qtl2_intervals_overlapping", (DL_FUNC) &_qtl2_intervals_overlapping, 5},
     {"_qtl2_calc_rss_linreg", (DL_FUNC) &_qtl2_calc_rss_linreg, 3},
     {"_qtl2_calc_coef_linreg", (DL_FUNC) &_qtl2_calc_coef_linreg, 3},
     {"_qtl2_calc_coefSE_linreg", (DL_FUNC) &_qtl2_calc_coefSE_linreg, 3},
@@ -2492,6 +3053,8 @@ static const R_CallMethodDef CallEntries[] = {
     {"_qtl2_Rcpp_calcLL", (DL_FUNC) &_qtl2_Rcpp_calcLL, 6},
     {"_qtl2_Rcpp_fitLMM", (DL_FUNC) &_qtl2_Rcpp_fitLMM, 7},
     {"_qtl2_Rcpp_fitLMM_mat", (DL_FUNC) &_qtl2_Rcpp_fitLMM_mat, 7},
+    {"_qtl2_fit_lmm_binary_pql", (DL_FUNC) &_qtl2_fit_lmm_binary_pql, 8},
+    {"_qtl2_fit_lmm_binary_pql_start", (DL_FUNC) &_qtl2_fit_lmm_binary_pql_start, 11},
     {"_qtl2_locate_xo", (DL_FUNC) &_qtl2_locate_xo, 4},
     {"_qtl2_R_lod_int_plain", (DL_FUNC) &_qtl2_R_lod_int_plain, 2},
     {"_qtl2_find_matching_cols", (DL_FUNC) &_qtl2_find_matching_cols, 2},
@@ -2504,7 +3067,12 @@ static const R_CallMethodDef CallEntries[] = {
     {"_qtl2_matrix_x_vector", (DL_FUNC) &_qtl2_matrix_x_vector, 2},
     {"_qtl2_matrix_x_3darray", (DL_FUNC) &_qtl2_matrix_x_3darray, 2},
     {"_qtl2_maxmarg", (DL_FUNC) &_qtl2_maxmarg, 3},
+    {"_qtl2_linkage_groups", (DL_FUNC) &_qtl2_linkage_groups, 3},
+    {"_qtl2_order_tsp", (DL_FUNC) &_qtl2_order_tsp, 2},
+    {"_qtl2_path_length", (DL_FUNC) &_qtl2_path_length, 2},
+    {"_qtl2_parse_vcf_lines", (DL_FUNC) &_qtl2_parse_vcf_lines, 4},
     {"_qtl2_predict_snpgeno", (DL_FUNC) &_qtl2_predict_snpgeno, 3},
+    {"_qtl2_predict_snpdosage", (DL_FUNC) &_qtl2_predict_snpdosage, 2},
     {"_qtl2_random_int", (DL_FUNC) &_qtl2_random_int, 3},
     {"_qtl2_get_permutation", (DL_FUNC) &_qtl2_get_permutation, 1},
     {"_qtl2_permute_nvector", (DL_FUNC) &_qtl2_permute_nvector, 2},
@@ -2525,10 +3093,12 @@ static const R_CallMethodDef CallEntries[] = {
     {"_qtl2_scan_hk_onechr_intcovar_weighted_highmem", (DL_FUNC) &_qtl2_scan_hk_onechr_intcovar_weighted_highmem, 6},
     {"_qtl2_scan_hk_onechr_intcovar_lowmem", (DL_FUNC) &_qtl2_scan_hk_onechr_intcovar_lowmem, 5},
     {"_qtl2_scan_hk_onechr_intcovar_weighted_lowmem", (DL_FUNC) &_qtl2_scan_hk_onechr_intcovar_weighted_lowmem, 6},
+    {"_qtl2_scan_hk_onechr_multi", (DL_FUNC) &_qtl2_scan_hk_onechr_multi, 3},
     {"_qtl2_scan_pg_onechr", (DL_FUNC) &_qtl2_scan_pg_onechr, 6},
     {"_qtl2_scan_pg_onechr_intcovar_highmem", (DL_FUNC) &_qtl2_scan_pg_onechr_intcovar_highmem, 7},
     {"_qtl2_scan_pg_onechr_intcovar_lowmem", (DL_FUNC) &_qtl2_scan_pg_onechr_intcovar_lowmem, 7},
     {"_qtl2_scanblup", (DL_FUNC) &_qtl2_scanblup, 6},
+    {"_qtl2_boot_peaks_hk_onechr", (DL_FUNC) &_qtl2_boot_peaks_hk_onechr, 5},
     {"_qtl2_scancoef_binary_addcovar", (DL_FUNC) &_qtl2_scancoef_binary_addcovar, 8},
     {"_qtl2_scancoef_binary_intcovar", (DL_FUNC) &_qtl2_scancoef_binary_intcovar, 9},
     {"_qtl2_scancoefSE_binary_addcovar", (DL_FUNC) &_qtl2_scancoefSE_binary_addcovar, 8},
@@ -2541,6 +3111,15 @@ static const R_CallMethodDef CallEntries[] = {
     {"_qtl2_scancoef_pg_intcovar", (DL_FUNC) &_qtl2_scancoef_pg_intcovar, 7},
     {"_qtl2_scancoefSE_pg_addcovar", (DL_FUNC) &_qtl2_scancoefSE_pg_addcovar, 6},
     {"_qtl2_scancoefSE_pg_intcovar", (DL_FUNC) &_qtl2_scancoefSE_pg_intcovar, 7},
+    {"_qtl2_calc_orthobasis", (DL_FUNC) &_qtl2_calc_orthobasis, 2},
+    {"_qtl2_project_out_matrix", (DL_FUNC) &_qtl2_project_out_matrix, 2},
+    {"_qtl2_project_out_3darray", (DL_FUNC) &_qtl2_project_out_3darray, 3},
+    {"_qtl2_scan_mediators", (DL_FUNC) &_qtl2_scan_mediators, 6},
+    {"_qtl2_scan_hk_lowrank", (DL_FUNC) &_qtl2_scan_hk_lowrank, 4},
+    {"_qtl2_simd_level", (DL_FUNC) &_qtl2_simd_level, 1},
+    {"_qtl2_simd_available", (DL_FUNC) &_qtl2_simd_available, 0},
+    {"_qtl2_genocol_to_dosage", (DL_FUNC) &_qtl2_genocol_to_dosage, 3},
+    {"_qtl2_snp_dosage_fixedpoint", (DL_FUNC) &_qtl2_snp_dosage_fixedpoint, 6},
     {"_qtl2_calc_sdp", (DL_FUNC) &_qtl2_calc_sdp, 1},
     {"_qtl2_invert_sdp", (DL_FUNC) &_qtl2_invert_sdp, 2},
     {"_qtl2_alleleprob_to_snpprob", (DL_FUNC) &_qtl2_alleleprob_to_snpprob, 4},
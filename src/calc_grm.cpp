@@ -0,0 +1,159 @@
+// genomic relationship matrix (GRM) from SNP genotypes
+//
+// For the allele-sharing similarity, the genotypes are packed into three
+// bit planes (typed, AB, BB), 64 SNPs per word, so that the sums over
+// SNPs for a pair of individuals are calculated with popcounts. With
+// x and y the number of B alleles (0, 1, or 2), the similarity at a SNP
+// is (1 - x/2)(1 - y/2) + (x/2)(y/2) = 1 - (x+y)/2 + xy/2.
+//
+// For the standardized GRM, blocks of SNPs are converted to standardized
+// genotypes with a per-SNP lookup table and accumulated with a
+// symmetric rank update.
+
+// [[Rcpp::depends(RcppEigen)]]
+
+#include "calc_grm.h"
+#include <math.h>
+#include <stdint.h>
+#include <vector>
+#include <algorithm>
+#include <RcppEigen.h>
+
+using namespace Rcpp;
+using namespace Eigen;
+
+// number of individuals per tile
+static const int IND_BLOCK = 64;
+
+// number of SNPs per block, for the standardized GRM
+static const int SNP_BLOCK = 512;
+
+static inline int popcount64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// check SNP genotypes; return 0 for missing, otherwise 1/2/3
+static inline int snpgeno_code(const int g)
+{
+    if(g == NA_INTEGER || g == 0) return 0;
+    if(g < 0 || g > 3)
+        throw std::invalid_argument("SNP genotypes should be 1, 2, 3, or missing");
+    return g;
+}
+
+// allele-sharing similarity from SNP genotypes, via 2-bit packed genotypes
+// [[Rcpp::export(".calc_grm_ibs")]]
+List calc_grm_ibs(const IntegerMatrix& geno)
+{
+    const int n_ind = geno.rows();
+    const int n_snp = geno.cols();
+    const int n_words = (n_snp + 63)/64;
+
+    // bit planes, individual-major: typed, AB, BB
+    std::vector<uint64_t> typed(n_ind*n_words, 0), het(n_ind*n_words, 0), homB(n_ind*n_words, 0);
+    for(int snp=0; snp<n_snp; snp++) {
+        const int word = snp/64;
+        const uint64_t bit = (uint64_t)1 << (snp % 64);
+        for(int ind=0; ind<n_ind; ind++) {
+            const int g = snpgeno_code(geno(ind, snp));
+            if(g == 0) continue;
+            typed[ind*n_words + word] |= bit;
+            if(g == 2) het[ind*n_words + word] |= bit;
+            else if(g == 3) homB[ind*n_words + word] |= bit;
+        }
+    }
+
+    NumericMatrix sum(n_ind, n_ind), n(n_ind, n_ind);
+
+    // tiles of individuals
+    for(int block_i=0; block_i<n_ind; block_i += IND_BLOCK) {
+        Rcpp::checkUserInterrupt();  // check for ^C from user
+        const int end_i = (block_i + IND_BLOCK < n_ind) ? block_i + IND_BLOCK : n_ind;
+
+        for(int block_j=block_i; block_j<n_ind; block_j += IND_BLOCK) {
+            const int end_j = (block_j + IND_BLOCK < n_ind) ? block_j + IND_BLOCK : n_ind;
+
+            for(int i=block_i; i<end_i; i++) {
+                const uint64_t *mi = &typed[i*n_words], *hi = &het[i*n_words], *bi = &homB[i*n_words];
+
+                for(int j=(block_j > i ? block_j : i); j<end_j; j++) {
+                    const uint64_t *mj = &typed[j*n_words], *hj = &het[j*n_words], *bj = &homB[j*n_words];
+
+                    // with counts in units of B alleles
+                    // (AB/BB and BB/AB can't both occur at a SNP, so the OR is a sum)
+                    long n_both=0, sum_x=0, sum_xy=0;
+                    for(int w=0; w<n_words; w++) {
+                        const uint64_t both = mi[w] & mj[w];
+                        n_both += popcount64(both);
+                        sum_x += popcount64(hi[w] & both) + 2*popcount64(bi[w] & both) +
+                            popcount64(hj[w] & both) + 2*popcount64(bj[w] & both);
+                        sum_xy += popcount64(hi[w] & hj[w]) + 2*popcount64((hi[w] & bj[w]) | (bi[w] & hj[w])) +
+                            4*popcount64(bi[w] & bj[w]);
+                    }
+
+                    sum(i,j) = sum(j,i) = (double)n_both - (double)sum_x/2.0 + (double)sum_xy/2.0;
+                    n(i,j) = n(j,i) = (double)n_both;
+                }
+            }
+        }
+    }
+
+    return List::create(Named("sum") = sum, Named("n") = n);
+}
+
+// standardized genomic relationship matrix from SNP genotypes
+// [[Rcpp::export(".calc_grm_std")]]
+List calc_grm_std(const IntegerMatrix& geno)
+{
+    const int n_ind = geno.rows();
+    const int n_snp = geno.cols();
+
+    MatrixXd sum = MatrixXd::Zero(n_ind, n_ind);
+    MatrixXd Z(n_ind, SNP_BLOCK);
+    int n_used = 0;
+
+    for(int block=0; block<n_snp; block += SNP_BLOCK) {
+        Rcpp::checkUserInterrupt();  // check for ^C from user
+        const int end = (block + SNP_BLOCK < n_snp) ? block + SNP_BLOCK : n_snp;
+
+        int col = 0;
+        for(int snp=block; snp<end; snp++) {
+            // allele frequency
+            int n_typed=0, n_B=0;
+            for(int ind=0; ind<n_ind; ind++) {
+                const int g = snpgeno_code(geno(ind, snp));
+                if(g == 0) continue;
+                n_typed++;
+                n_B += g-1;
+            }
+            if(n_typed == 0) continue;
+            const double p = (double)n_B / (double)(2*n_typed);
+            if(p <= 0.0 || p >= 1.0) continue; // monomorphic
+
+            // lookup table: missing, AA, AB, BB
+            const double sd = sqrt(2.0*p*(1.0-p));
+            const double table[4] = {0.0, (0.0 - 2.0*p)/sd, (1.0 - 2.0*p)/sd, (2.0 - 2.0*p)/sd};
+            for(int ind=0; ind<n_ind; ind++)
+                Z(ind, col) = table[snpgeno_code(geno(ind, snp))];
+            col++;
+        }
+        if(col == 0) continue;
+        n_used += col;
+
+        sum.selfadjointView<Lower>().rankUpdate(Z.leftCols(col));
+    }
+    sum.triangularView<StrictlyUpper>() = sum.transpose();
+
+    NumericMatrix n(n_ind, n_ind);
+    std::fill(n.begin(), n.end(), (double)n_used);
+
+    return List::create(Named("sum") = wrap(sum), Named("n") = n);
+}
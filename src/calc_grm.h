@@ -0,0 +1,27 @@
+// genomic relationship matrix (GRM) from SNP genotypes
+#ifndef CALC_GRM_H
+#define CALC_GRM_H
+
+#include <Rcpp.h>
+
+// allele-sharing similarity from SNP genotypes, via 2-bit packed genotypes
+//
+// geno   = matrix of SNP genotypes (individuals x SNPs), coded 1/2/3 (AA/AB/BB),
+//          with 0 or NA for missing
+//
+// output = list with components "sum" (sum over SNPs of the allele-sharing
+//          similarity for each pair of individuals) and "n" (number of SNPs
+//          with both individuals typed)
+Rcpp::List calc_grm_ibs(const Rcpp::IntegerMatrix& geno);
+
+// standardized genomic relationship matrix from SNP genotypes
+//
+// geno   = matrix of SNP genotypes (individuals x SNPs), coded 1/2/3 (AA/AB/BB),
+//          with 0 or NA for missing
+//
+// output = list with components "sum" (sum over SNPs of the products of
+//          standardized genotypes, with missing values set to 0) and "n"
+//          (number of polymorphic SNPs, in each cell)
+Rcpp::List calc_grm_std(const Rcpp::IntegerMatrix& geno);
+
+#endif // CALC_GRM_H
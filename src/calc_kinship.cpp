@@ -2,6 +2,7 @@
 
 #include "calc_kinship.h"
 #include <Rcpp.h>
+#include "simd_kernels.h"
 using namespace Rcpp;
 
 
@@ -24,13 +25,7 @@ NumericMatrix calc_kinship(const NumericVector& prob_array) // array as n_pos x
         Rcpp::checkUserInterrupt();  // check for ^C from user
         for(int ind_j=ind_i, offset_j=ind_i*pos_by_gen; ind_j<n_ind; ind_j++, offset_j += pos_by_gen) {
 
-            double total = 0.0;
-            for(int pos=0; pos<n_pos; pos++) {
-                for(int gen=0; gen<n_gen; gen++) {
-                    total += prob_array[pos + gen*n_pos + offset_i] *
-                        prob_array[pos + gen*n_pos + offset_j];
-                }
-            }
+            const double total = simd_dot(prob_array.begin() + offset_i, prob_array.begin() + offset_j, pos_by_gen);
             result(ind_i,ind_j) = result(ind_j,ind_i) = total;
         }
     }
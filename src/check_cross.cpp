@@ -1,6 +1,8 @@
 // functions to check QTL cross data/information
 
 #include "check_cross.h"
+#include <map>
+#include <vector>
 #include <Rcpp.h>
 #include "cross.h"
 
@@ -51,6 +53,98 @@ IntegerVector count_invalid_genotypes(const String& crosstype,
     return result;
 }
 
+// find invalid genotypes in one pass, with a lookup table of allowed
+// observed codes for each distinct (is_female, cross_info)
+// [[Rcpp::export(".find_invalid_genotypes")]]
+List find_invalid_genotypes(const String& crosstype,
+                            const IntegerMatrix& genotypes, // rows are individuals, columns are markers
+                            const bool is_X_chr,
+                            const LogicalVector& is_female,
+                            const IntegerMatrix& cross_info, // rows are individuals
+                            const int max_cells)
+{
+    const int n_ind = genotypes.rows();
+    const int n_mar = genotypes.cols();
+    const int n_info = cross_info.cols();
+    const int table_size = 256; // observed codes 0..255 use the lookup table
+
+    if(is_female.size() != n_ind)
+        throw std::range_error("length(is_female) != nrow(genotypes)");
+    if(cross_info.rows() != n_ind)
+        throw std::range_error("nrow(cross_info) != nrow(genotypes)");
+
+    QTLCross* cross = QTLCross::Create(crosstype);
+
+    // assign individuals to classes with the same (is_female, cross_info)
+    std::map< std::vector<int>, int > class_index;
+    std::vector<int> ind_class(n_ind);
+    std::vector<IntegerVector> class_info;
+    std::vector<bool> class_female;
+    for(int ind=0; ind<n_ind; ind++) {
+        std::vector<int> key(n_info+1);
+        key[0] = is_female[ind];
+        for(int j=0; j<n_info; j++) key[j+1] = cross_info(ind,j);
+
+        std::map< std::vector<int>, int >::iterator it = class_index.find(key);
+        if(it == class_index.end()) {
+            const int this_class = class_info.size();
+            class_index[key] = this_class;
+            class_info.push_back(cross_info(ind,_));
+            class_female.push_back(is_female[ind]);
+            ind_class[ind] = this_class;
+        }
+        else ind_class[ind] = it->second;
+    }
+
+    // lookup table of allowed observed codes, by class
+    const int n_class = class_info.size();
+    std::vector<char> allowed(n_class * table_size);
+    for(int k=0; k<n_class; k++) {
+        for(int g=0; g<table_size; g++)
+            allowed[k*table_size + g] = cross->check_geno(g, true, is_X_chr, class_female[k], class_info[k]);
+    }
+
+    IntegerVector n_invalid(n_ind);
+    std::vector<int> cell_ind, cell_mar, cell_geno;
+
+    for(int mar=0; mar<n_mar; mar++) {
+        Rcpp::checkUserInterrupt();  // check for ^C from user
+
+        for(int ind=0; ind<n_ind; ind++) {
+            const int g = genotypes(ind,mar);
+            bool ok;
+            if(g >= 0 && g < table_size)
+                ok = allowed[ind_class[ind]*table_size + g];
+            else
+                ok = cross->check_geno(g, true, is_X_chr, class_female[ind_class[ind]],
+                                       class_info[ind_class[ind]]);
+
+            if(!ok) {
+                ++n_invalid[ind];
+                if((int)cell_ind.size() < max_cells) {
+                    cell_ind.push_back(ind+1);
+                    cell_mar.push_back(mar+1);
+                    cell_geno.push_back(g);
+                }
+            }
+        }
+    }
+
+    delete cross;
+
+    const int n_cells = cell_ind.size();
+    IntegerMatrix cells(n_cells, 3);
+    for(int i=0; i<n_cells; i++) {
+        cells(i,0) = cell_ind[i];
+        cells(i,1) = cell_mar[i];
+        cells(i,2) = cell_geno[i];
+    }
+    colnames(cells) = CharacterVector::create("ind", "marker", "genotype");
+
+    return List::create(Named("n_invalid") = n_invalid,
+                        Named("cells") = cells);
+}
+
 // check cross info
 // [[Rcpp::export(".check_crossinfo")]]
 bool check_crossinfo(const String& crosstype,
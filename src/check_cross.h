@@ -14,6 +14,26 @@ Rcpp::IntegerVector count_invalid_genotypes(const Rcpp::String& crosstype,
                                             const Rcpp::LogicalVector& is_female,
                                             const Rcpp::IntegerMatrix& cross_info); // columns are individuals
 
+// find invalid genotypes in one pass, with a lookup table of allowed
+// observed codes for each distinct (is_female, cross_info)
+//
+// genotypes  = individuals x markers
+// is_X_chr   = whether this is the X chromosome
+// is_female  = logical vector of sexes
+// cross_info = individuals x k matrix of cross information
+// max_cells  = maximum number of invalid cells to report
+//
+// output = list with n_invalid (number of invalid genotypes for each
+//          individual) and cells (matrix with up to max_cells rows and
+//          columns ind, marker, genotype, for the first invalid cells
+//          in marker order, with ind and marker 1-based)
+Rcpp::List find_invalid_genotypes(const Rcpp::String& crosstype,
+                                  const Rcpp::IntegerMatrix& genotypes,
+                                  const bool is_X_chr,
+                                  const Rcpp::LogicalVector& is_female,
+                                  const Rcpp::IntegerMatrix& cross_info,
+                                  const int max_cells);
+
 // check cross info
 bool check_crossinfo(const Rcpp::String& crosstype,
                      const Rcpp::IntegerMatrix& cross_info,
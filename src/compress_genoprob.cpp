@@ -0,0 +1,55 @@
+// compress genotype probabilities by grouping equivalent adjacent positions
+//
+// In a dense grid, adjacent positions with no informative crossover
+// between them have the same probabilities in every individual. Each
+// run of such positions is represented by its first position.
+
+#include "compress_genoprob.h"
+#include <math.h>
+#include <Rcpp.h>
+
+using namespace Rcpp;
+
+// group adjacent positions with equivalent probabilities
+// [[Rcpp::export(".find_equiv_positions")]]
+IntegerVector find_equiv_positions(const NumericVector& prob_array,
+                                   const double tol)
+{
+    if(Rf_isNull(prob_array.attr("dim")))
+        throw std::invalid_argument("prob_array should be a 3d array but has no dim attribute");
+    const IntegerVector& dim = prob_array.attr("dim");
+    if(dim.size() != 3)
+        throw std::invalid_argument("prob_array should be a 3d array of probabilities");
+    if(tol < 0.0)
+        throw std::invalid_argument("tol should be >= 0");
+    const int matsize = dim[0]*dim[1];
+    const int n_pos = dim[2];
+
+    IntegerVector result(n_pos);
+    if(n_pos == 0) return result;
+
+    int group = 1;
+    const double* rep = &(prob_array[0]); // first position in current group
+    result[0] = group;
+    for(int pos=1; pos<n_pos; pos++) {
+        Rcpp::checkUserInterrupt();  // check for ^C from user
+
+        const double* p = &(prob_array[pos*matsize]);
+        bool same = true;
+        for(int i=0; i<matsize; i++) {
+            // (missing values are equivalent only to missing values)
+            if(ISNAN(p[i]) || ISNAN(rep[i])) {
+                if(ISNAN(p[i]) != ISNAN(rep[i])) { same = false; break; }
+            }
+            else if(fabs(p[i] - rep[i]) > tol) { same = false; break; }
+        }
+
+        if(!same) {
+            group++;
+            rep = p;
+        }
+        result[pos] = group;
+    }
+
+    return result;
+}
@@ -0,0 +1,17 @@
+// compress genotype probabilities by grouping equivalent adjacent positions
+#ifndef COMPRESS_GENOPROB_H
+#define COMPRESS_GENOPROB_H
+
+#include <Rcpp.h>
+
+// group adjacent positions with equivalent probabilities
+//
+// prob_array = 3d array of probabilities (individuals x genotypes x positions)
+// tol        = tolerance; a position is equivalent to the first position in
+//              the current group if no probability differs by more than tol
+//
+// output = integer vector with the group for each position (starting at 1)
+Rcpp::IntegerVector find_equiv_positions(const Rcpp::NumericVector& prob_array,
+                                         const double tol);
+
+#endif // COMPRESS_GENOPROB_H
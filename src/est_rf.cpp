@@ -0,0 +1,333 @@
+// estimate recombination fractions and LOD scores for pairs of markers
+//
+// Within each group of individuals (with common sex and cross_info), the
+// observed genotypes are packed into bit planes, one per marker and
+// observed genotype, 64 individuals per word, so that the two-locus
+// genotype counts for a pair of markers are calculated with popcounts.
+// The two-locus genotype probabilities come from the cross's init, emit,
+// and step functions, and the log likelihood is maximized over the
+// recombination fraction by Brent's method. The pairs are taken in
+// tiles of markers, to keep the bit planes in cache.
+
+#include "est_rf.h"
+#include <math.h>
+#include <stdint.h>
+#include <vector>
+#include <algorithm>
+#include <Rcpp.h>
+#include "cross.h"
+#include "brent_fmin.h"
+
+using namespace Rcpp;
+
+// number of markers per tile
+static const int MAR_BLOCK = 64;
+
+static inline int popcount64(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// a group of individuals with common sex and cross_info
+struct rf_group {
+    bool is_female;
+    IntegerVector cross_info;
+    IntegerVector poss_gen;
+    std::vector<double> init;     // initial probabilities
+    int n_words;
+    std::vector<uint64_t> planes; // bit planes, n_mar x n_obs x n_words
+    std::vector<bool> nonempty;   // n_mar x n_obs
+};
+
+// information for the likelihood for one pair of markers
+struct rf_pair_args {
+    QTLCross* cross;
+    bool is_X_chr;
+    int n_obs;
+    std::vector<rf_group>* groups;
+    std::vector<int> group_used;          // groups with any counts
+    std::vector< std::vector<double> > ie1; // per used group: init x emit at marker 1, n_obs x n_gen
+    std::vector< std::vector<double> > e2;  // per used group: emit at marker 2, n_obs x n_gen
+    std::vector< std::vector<double> > count; // per used group: n_obs x n_obs
+    std::vector<double> step;  // workspace, n_gen x n_gen
+    std::vector<double> work;  // workspace, n_gen x n_obs
+};
+
+// negative log likelihood for a pair of markers, as a function of the recombination fraction
+static double rf_negloglik(const double rec_frac, struct rf_pair_args *args)
+{
+    const int n_obs = args->n_obs;
+    double loglik = 0.0;
+
+    for(unsigned int k=0; k<args->group_used.size(); k++) {
+        const rf_group& grp = (*args->groups)[args->group_used[k]];
+        const int n_gen = grp.poss_gen.size();
+        const std::vector<double>& ie1 = args->ie1[k];
+        const std::vector<double>& e2 = args->e2[k];
+        const std::vector<double>& count = args->count[k];
+
+        // transition matrix
+        for(int g1=0; g1<n_gen; g1++)
+            for(int g2=0; g2<n_gen; g2++)
+                args->step[g1*n_gen+g2] = exp(args->cross->step(grp.poss_gen[g1], grp.poss_gen[g2], rec_frac,
+                                                                args->is_X_chr, grp.is_female, grp.cross_info));
+
+        // work[g1,o2] = sum_g2 step[g1,g2] e2[o2,g2]
+        for(int g1=0; g1<n_gen; g1++) {
+            for(int o2=0; o2<n_obs; o2++) {
+                double val = 0.0;
+                for(int g2=0; g2<n_gen; g2++) val += args->step[g1*n_gen+g2] * e2[o2*n_gen+g2];
+                args->work[g1*n_obs+o2] = val;
+            }
+        }
+
+        for(int o1=0; o1<n_obs; o1++) {
+            for(int o2=0; o2<n_obs; o2++) {
+                const double n = count[o1*n_obs+o2];
+                if(n == 0.0) continue;
+                double p = 0.0;
+                for(int g1=0; g1<n_gen; g1++) p += ie1[o1*n_gen+g1] * args->work[g1*n_obs+o2];
+                loglik += n * log(p);
+            }
+        }
+    }
+
+    return -loglik;
+}
+
+// estimate recombination fraction and linkage LOD score for pairs of markers
+// [[Rcpp::export(".est_rf")]]
+List est_rf(const String& crosstype,
+            const IntegerMatrix& genotypes, // columns are individuals, rows are markers
+            const IntegerMatrix& founder_geno, // columns are markers, rows are founder lines
+            const bool is_X_chr,
+            const LogicalVector& is_female, // length n_ind
+            const IntegerMatrix& cross_info, // columns are individuals
+            const IntegerVector& cross_group, // length n_ind, values from 0
+            const IntegerVector& unique_cross_group, // representative individual per group, from 0
+            const IntegerVector& markerA, // row markers, from 0
+            const IntegerVector& markerB, // column markers, from 0
+            const NumericVector& pos, // marker positions
+            const double max_dist,
+            const double min_lod,
+            const bool sparse,
+            const double error_prob,
+            const double tol)
+{
+    const int n_ind = genotypes.cols();
+    const int n_mar = genotypes.rows();
+    const int n_A = markerA.size();
+    const int n_B = markerB.size();
+    const int n_groups = unique_cross_group.size();
+
+    QTLCross* cross = QTLCross::Create(crosstype);
+
+    // check inputs
+    if(is_female.size() != n_ind)
+        throw std::range_error("length(is_female) != ncol(genotypes)");
+    if(cross_info.cols() != n_ind)
+        throw std::range_error("ncols(cross_info) != ncol(genotypes)");
+    if(cross_group.size() != n_ind)
+        throw std::range_error("length(cross_group) != ncol(genotypes)");
+    if(pos.size() != n_mar)
+        throw std::range_error("length(pos) != nrow(genotypes)");
+    if(error_prob < 0.0 || error_prob > 1.0)
+        throw std::range_error("error_prob out of range");
+    if(!cross->check_founder_geno_size(founder_geno, n_mar))
+        throw std::range_error("founder_geno is not the right size");
+    for(int i=0; i<n_ind; i++) {
+        if(cross_group[i] < 0 || cross_group[i] >= n_groups)
+            throw std::range_error("cross_group out of range");
+    }
+    for(int i=0; i<n_groups; i++) {
+        if(unique_cross_group[i] < 0 || unique_cross_group[i] >= n_ind)
+            throw std::range_error("unique_cross_group out of range");
+    }
+    for(int i=0; i<n_A; i++) {
+        if(markerA[i] < 0 || markerA[i] >= n_mar)
+            throw std::range_error("markerA out of range");
+    }
+    for(int i=0; i<n_B; i++) {
+        if(markerB[i] < 0 || markerB[i] >= n_mar)
+            throw std::range_error("markerB out of range");
+    }
+    // end of checks
+
+    // largest observed genotype
+    int n_obs = 0;
+    for(int i=0; i<genotypes.size(); i++)
+        if(genotypes[i] != NA_INTEGER && genotypes[i] > n_obs) n_obs = genotypes[i];
+
+    // groups of individuals, with bit planes for the observed genotypes
+    std::vector<rf_group> groups(n_groups);
+    std::vector<int> ind_in_group(n_ind);
+    std::vector<int> group_size(n_groups, 0);
+    for(int i=0; i<n_ind; i++) ind_in_group[i] = group_size[cross_group[i]]++;
+
+    for(int g=0; g<n_groups; g++) {
+        const int ind = unique_cross_group[g];
+        rf_group& grp = groups[g];
+        grp.is_female = is_female[ind];
+        grp.cross_info = cross_info(_, ind);
+        grp.poss_gen = cross->possible_gen(is_X_chr, grp.is_female, grp.cross_info);
+        for(int k=0; k<grp.poss_gen.size(); k++)
+            grp.init.push_back(exp(cross->init(grp.poss_gen[k], is_X_chr, grp.is_female, grp.cross_info)));
+        grp.n_words = (group_size[g] + 63)/64;
+        grp.planes.assign((size_t)n_mar * n_obs * grp.n_words, 0);
+        grp.nonempty.assign((size_t)n_mar * n_obs, false);
+    }
+
+    for(int ind=0; ind<n_ind; ind++) {
+        rf_group& grp = groups[cross_group[ind]];
+        const int word = ind_in_group[ind] / 64;
+        const uint64_t bit = (uint64_t)1 << (ind_in_group[ind] % 64);
+        for(int mar=0; mar<n_mar; mar++) {
+            const int obs = genotypes(mar, ind);
+            if(obs == NA_INTEGER || obs <= 0) continue;
+            const size_t plane = (size_t)mar*n_obs + (obs-1);
+            grp.planes[plane*grp.n_words + word] |= bit;
+            grp.nonempty[plane] = true;
+        }
+    }
+
+    // space for result
+    NumericMatrix rf(sparse ? 0 : n_A, sparse ? 0 : n_B);
+    NumericMatrix lod(sparse ? 0 : n_A, sparse ? 0 : n_B);
+    std::fill(rf.begin(), rf.end(), NA_REAL);
+    std::fill(lod.begin(), lod.end(), NA_REAL);
+    std::vector<int> sp_marker1, sp_marker2;
+    std::vector<double> sp_rf, sp_lod;
+
+    struct rf_pair_args args;
+    args.cross = cross;
+    args.is_X_chr = is_X_chr;
+    args.n_obs = n_obs;
+    args.groups = &groups;
+
+    int max_gen = 0;
+    for(int g=0; g<n_groups; g++)
+        if(groups[g].poss_gen.size() > max_gen) max_gen = groups[g].poss_gen.size();
+    args.step.resize(max_gen*max_gen);
+    args.work.resize(max_gen*n_obs);
+
+    for(int blockA=0; blockA<n_A; blockA += MAR_BLOCK) {
+        Rcpp::checkUserInterrupt();  // check for ^C from user
+
+        const int endA = std::min(blockA + MAR_BLOCK, n_A);
+        for(int blockB=0; blockB<n_B; blockB += MAR_BLOCK) {
+            const int endB = std::min(blockB + MAR_BLOCK, n_B);
+
+            for(int i=blockA; i<endA; i++) {
+                const int a = markerA[i];
+                for(int j=blockB; j<endB; j++) {
+                    const int b = markerB[j];
+                    if(b <= a) continue;
+                    if(fabs(pos[b] - pos[a]) > max_dist) continue;
+
+                    // two-locus genotype counts, plus emission probabilities
+                    args.group_used.clear();
+                    args.ie1.clear();
+                    args.e2.clear();
+                    args.count.clear();
+                    double nulllik = 0.0;
+
+                    for(int g=0; g<n_groups; g++) {
+                        const rf_group& grp = groups[g];
+                        const int n_words = grp.n_words;
+                        std::vector<double> count(n_obs*n_obs, 0.0);
+                        bool any = false;
+                        for(int o1=0; o1<n_obs; o1++) {
+                            const size_t plane1 = (size_t)a*n_obs + o1;
+                            if(!grp.nonempty[plane1]) continue;
+                            const uint64_t* p1 = &grp.planes[plane1*n_words];
+                            for(int o2=0; o2<n_obs; o2++) {
+                                const size_t plane2 = (size_t)b*n_obs + o2;
+                                if(!grp.nonempty[plane2]) continue;
+                                const uint64_t* p2 = &grp.planes[plane2*n_words];
+                                int n = 0;
+                                for(int w=0; w<n_words; w++) n += popcount64(p1[w] & p2[w]);
+                                if(n > 0) {
+                                    count[o1*n_obs+o2] = (double)n;
+                                    any = true;
+                                }
+                            }
+                        }
+                        if(!any) continue;
+
+                        const int n_gen = grp.poss_gen.size();
+                        std::vector<double> ie1(n_obs*n_gen), e2(n_obs*n_gen);
+                        std::vector<double> marg1(n_obs, 0.0), marg2(n_obs, 0.0);
+                        for(int o=0; o<n_obs; o++) {
+                            for(int k=0; k<n_gen; k++) {
+                                ie1[o*n_gen+k] = grp.init[k] *
+                                    exp(cross->emit(o+1, grp.poss_gen[k], error_prob, founder_geno(_, a),
+                                                    is_X_chr, grp.is_female, grp.cross_info));
+                                e2[o*n_gen+k] = exp(cross->emit(o+1, grp.poss_gen[k], error_prob, founder_geno(_, b),
+                                                                is_X_chr, grp.is_female, grp.cross_info));
+                                marg1[o] += ie1[o*n_gen+k];
+                                marg2[o] += grp.init[k] * e2[o*n_gen+k];
+                            }
+                        }
+
+                        // log likelihood with the markers unlinked
+                        for(int o1=0; o1<n_obs; o1++)
+                            for(int o2=0; o2<n_obs; o2++)
+                                if(count[o1*n_obs+o2] > 0.0)
+                                    nulllik += count[o1*n_obs+o2] * log(marg1[o1]*marg2[o2]);
+
+                        args.group_used.push_back(g);
+                        args.ie1.push_back(ie1);
+                        args.e2.push_back(e2);
+                        args.count.push_back(count);
+                    }
+                    if(args.group_used.empty()) continue; // no individuals typed at both
+
+                    // maximize likelihood, checking the end points
+                    double rhat = qtl2_Brent_fmin(0.0, 0.5, (double (*)(double, void*)) rf_negloglik,
+                                                  &args, tol);
+                    double negll = rf_negloglik(rhat, &args);
+                    const double ends[2] = {0.0, 0.5};
+                    for(int k=0; k<2; k++) {
+                        const double val = rf_negloglik(ends[k], &args);
+                        if(val <= negll) {
+                            negll = val;
+                            rhat = ends[k];
+                        }
+                    }
+                    const double lodval = (-negll - nulllik)/log(10.0);
+
+                    if(sparse) {
+                        if(lodval >= min_lod) {
+                            sp_marker1.push_back(a+1);
+                            sp_marker2.push_back(b+1);
+                            sp_rf.push_back(rhat);
+                            sp_lod.push_back(lodval);
+                        }
+                    }
+                    else {
+                        rf(i,j) = rhat;
+                        lod(i,j) = lodval;
+                    }
+                }
+            }
+        }
+    }
+
+    delete cross;
+
+    if(sparse) {
+        return List::create(Named("marker1") = wrap(sp_marker1),
+                            Named("marker2") = wrap(sp_marker2),
+                            Named("rf") = wrap(sp_rf),
+                            Named("lod") = wrap(sp_lod));
+    }
+
+    return List::create(Named("rf") = rf, Named("lod") = lod);
+}
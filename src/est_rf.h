@@ -0,0 +1,46 @@
+// estimate recombination fractions and LOD scores for pairs of markers
+#ifndef EST_RF_H
+#define EST_RF_H
+
+#include <Rcpp.h>
+
+// estimate recombination fraction and linkage LOD score for pairs of markers
+//
+// genotypes          = matrix of observed genotypes (markers x individuals)
+// founder_geno       = matrix of founder genotypes (founders x markers)
+// is_X_chr           = true if the markers are on the X chromosome
+// is_female          = logical vector of sexes (length n_ind)
+// cross_info         = matrix of cross information (columns are individuals)
+// cross_group        = group (from 0) of each individual, by common sex and cross_info
+// unique_cross_group = a representative individual (from 0) for each group
+// markerA            = row markers (indexes from 0)
+// markerB            = column markers (indexes from 0); only pairs with
+//                      markerB > markerA are considered
+// pos                = marker positions (length n_mar), for max_dist
+// max_dist           = only consider pairs of markers within this distance
+// min_lod            = in sparse output, only keep pairs with LOD >= min_lod
+// sparse             = if true, return just the selected pairs
+// error_prob         = genotyping error probability
+// tol                = tolerance for convergence in the estimated recombination fractions
+//
+// output  = if sparse=false, list with matrices "rf" and "lod", length(markerA) x length(markerB),
+//           with NA for pairs not considered; if sparse=true, list with vectors
+//           "marker1" and "marker2" (indexes from 1), "rf" and "lod"
+Rcpp::List est_rf(const Rcpp::String& crosstype,
+                  const Rcpp::IntegerMatrix& genotypes,
+                  const Rcpp::IntegerMatrix& founder_geno,
+                  const bool is_X_chr,
+                  const Rcpp::LogicalVector& is_female,
+                  const Rcpp::IntegerMatrix& cross_info,
+                  const Rcpp::IntegerVector& cross_group,
+                  const Rcpp::IntegerVector& unique_cross_group,
+                  const Rcpp::IntegerVector& markerA,
+                  const Rcpp::IntegerVector& markerB,
+                  const Rcpp::NumericVector& pos,
+                  const double max_dist,
+                  const double min_lod,
+                  const bool sparse,
+                  const double error_prob,
+                  const double tol);
+
+#endif // EST_RF_H
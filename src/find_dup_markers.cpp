@@ -0,0 +1,313 @@
+// find duplicate and non-informative markers
+
+#include "find_dup_markers.h"
+#include <stdint.h>
+#include <vector>
+#include <map>
+#include <set>
+#include <algorithm>
+#include <utility>
+#include <Rcpp.h>
+
+using namespace Rcpp;
+
+// maximum number of anchor individuals for the missing-tolerant search
+static const int MAX_ANCHORS = 32;
+
+// maximum number of completions of missing anchor genotypes to look up
+static const int MAX_COMPLETIONS = 256;
+
+// FNV-1a hash, a value at a time
+static inline uint64_t hash_value(uint64_t h, const int value)
+{
+    uint32_t v = (uint32_t)value;
+    for(int b=0; b<4; b++) {
+        h ^= (v & 0xFF);
+        h *= 1099511628211ULL;
+        v >>= 8;
+    }
+    return h;
+}
+
+static const uint64_t HASH_INIT = 14695981039346656037ULL;
+
+// hash of the founder genotypes at a marker
+static uint64_t hash_founders(const IntegerMatrix& founder_geno, const int mar)
+{
+    uint64_t h = HASH_INIT;
+    for(int f=0; f<founder_geno.rows(); f++) h = hash_value(h, founder_geno(f,mar));
+    return h;
+}
+
+// founder genotypes the same at two markers
+static bool same_founders(const IntegerMatrix& founder_geno, const int mar1, const int mar2)
+{
+    for(int f=0; f<founder_geno.rows(); f++)
+        if(founder_geno(f,mar1) != founder_geno(f,mar2)) return false;
+    return true;
+}
+
+// marker mar1 matches marker mar2 wherever mar1 is typed
+// (if exact, they must be the same everywhere)
+static bool matches(const IntegerMatrix& genotypes, const IntegerMatrix& founder_geno,
+                    const int mar1, const int mar2, const bool exact)
+{
+    if(!same_founders(founder_geno, mar1, mar2)) return false;
+
+    const int n_ind = genotypes.rows();
+    const int* g1 = &genotypes[mar1*n_ind];
+    const int* g2 = &genotypes[mar2*n_ind];
+    if(exact) {
+        for(int i=0; i<n_ind; i++)
+            if(g1[i] != g2[i]) return false;
+    }
+    else {
+        for(int i=0; i<n_ind; i++)
+            if(g1[i] != 0 && g1[i] != g2[i]) return false;
+    }
+    return true;
+}
+
+// runs of adjacent markers
+static void find_dup_adjacent(const IntegerMatrix& genotypes, const IntegerMatrix& founder_geno,
+                              const std::vector<int>& n_typed, const bool exact_only,
+                              IntegerVector& result)
+{
+    const int n_mar = genotypes.cols();
+    std::vector<int> run;
+    int rep = -1;
+
+    for(int mar=0; mar<n_mar; mar++) {
+        if(n_typed[mar] == 0) continue; // markers with no data are skipped
+
+        if(rep >= 0 && matches(genotypes, founder_geno, mar, rep, exact_only)) {
+            run.push_back(mar);
+        }
+        else if(rep >= 0 && !exact_only && matches(genotypes, founder_geno, rep, mar, false)) {
+            // new marker contains the representative, so it takes over the run
+            run.push_back(mar);
+            rep = mar;
+        }
+        else {
+            run.clear();
+            run.push_back(mar);
+            rep = mar;
+        }
+
+        for(unsigned int i=0; i<run.size(); i++) result[run[i]] = rep+1;
+    }
+}
+
+// representative markers found by hashing
+static void find_dup_hashed(const IntegerMatrix& genotypes, const IntegerMatrix& founder_geno,
+                            const std::vector<int>& n_typed, const bool exact_only,
+                            IntegerVector& result)
+{
+    const int n_ind = genotypes.rows();
+    const int n_mar = genotypes.cols();
+
+    // markers in order of decreasing number typed, so that representatives come first
+    std::vector< std::pair<int,int> > mar_order; // (-n_typed, marker)
+    for(int mar=0; mar<n_mar; mar++)
+        if(n_typed[mar] > 0) mar_order.push_back(std::make_pair(-n_typed[mar], mar));
+    std::sort(mar_order.begin(), mar_order.end());
+
+    if(exact_only) {
+        // hash of the complete genotype column
+        std::map< uint64_t, std::vector<int> > reps;
+        for(unsigned int k=0; k<mar_order.size(); k++) {
+            const int mar = mar_order[k].second;
+            if(k % 1000 == 0) Rcpp::checkUserInterrupt();  // check for ^C from user
+
+            uint64_t h = hash_founders(founder_geno, mar);
+            const int* g = &genotypes[mar*n_ind];
+            for(int i=0; i<n_ind; i++) h = hash_value(h, g[i]);
+
+            std::vector<int>& bucket = reps[h];
+            int rep = -1;
+            for(unsigned int j=0; j<bucket.size(); j++) {
+                if(matches(genotypes, founder_geno, mar, bucket[j], true)) {
+                    rep = bucket[j];
+                    break;
+                }
+            }
+            if(rep < 0) {
+                bucket.push_back(mar);
+                rep = mar;
+            }
+            result[mar] = rep+1;
+        }
+        return;
+    }
+
+    // missing-tolerant: hash the genotypes at a set of anchor individuals,
+    // those with the most genotypes on the chromosome. A marker matches a
+    // representative only if, at each anchor, it is missing or has the same
+    // genotype (including missing), so the missing anchor genotypes in a
+    // marker are filled in with each of the possibilities.
+    std::vector< std::pair<int,int> > ind_order(n_ind); // (-n_typed, individual)
+    for(int i=0; i<n_ind; i++) {
+        int n = 0;
+        for(int mar=0; mar<n_mar; mar++) if(genotypes(i,mar) != 0) n++;
+        ind_order[i] = std::make_pair(-n, i);
+    }
+    std::sort(ind_order.begin(), ind_order.end());
+    const int n_anchors = std::min(n_ind, MAX_ANCHORS);
+    std::vector<int> anchors(n_anchors);
+    for(int a=0; a<n_anchors; a++) anchors[a] = ind_order[a].second;
+
+    // possible anchor genotypes: missing or one of the observed genotypes
+    std::set<int> obs_set;
+    for(int i=0; i<genotypes.size(); i++)
+        if(genotypes[i] != 0) obs_set.insert(genotypes[i]);
+    std::vector<int> choices(1, 0);
+    choices.insert(choices.end(), obs_set.begin(), obs_set.end());
+    const int n_choices = choices.size();
+
+    // hash indexes on nested subsets of the anchors (all of them, the first half, ...),
+    // so that markers missing many of the anchors can use a smaller subset
+    std::vector<int> levels;
+    for(int n=n_anchors; n >= 1; n /= 2) {
+        levels.push_back(n);
+        if(n < 4) break;
+    }
+    const int n_levels = levels.size();
+    std::vector< std::multimap<uint64_t, int> > index(n_levels);
+    std::vector<int> reps;                // representatives, in the order added
+    std::vector<int> rep_rank(n_mar, -1);
+
+    std::vector<int> anchor_geno(n_anchors);
+    std::vector<int> missing;
+    for(unsigned int k=0; k<mar_order.size(); k++) {
+        const int mar = mar_order[k].second;
+        if(k % 1000 == 0) Rcpp::checkUserInterrupt();  // check for ^C from user
+
+        const uint64_t fhash = hash_founders(founder_geno, mar);
+        missing.clear();
+        for(int a=0; a<n_anchors; a++) {
+            anchor_geno[a] = genotypes(anchors[a], mar);
+            if(anchor_geno[a] == 0) missing.push_back(a);
+        }
+
+        // largest subset of anchors with a manageable number of completions
+        int level = -1, n_miss = 0, n_completions = 1;
+        for(int l=0; l<n_levels && level < 0; l++) {
+            n_miss = 0;
+            while(n_miss < (int)missing.size() && missing[n_miss] < levels[l]) n_miss++;
+            n_completions = 1;
+            for(int j=0; j<n_miss && n_completions <= MAX_COMPLETIONS; j++) n_completions *= n_choices;
+            if(n_completions <= MAX_COMPLETIONS) level = l;
+        }
+
+        // earliest representative that this marker matches
+        int rep = -1;
+        if(level >= 0) {
+            for(int c=0; c<n_completions; c++) {
+                int cc = c;
+                for(int j=0; j<n_miss; j++) {
+                    anchor_geno[missing[j]] = choices[cc % n_choices];
+                    cc /= n_choices;
+                }
+                uint64_t h = fhash;
+                for(int a=0; a<levels[level]; a++) h = hash_value(h, anchor_geno[a]);
+
+                std::pair<std::multimap<uint64_t,int>::iterator, std::multimap<uint64_t,int>::iterator>
+                    range = index[level].equal_range(h);
+                for(std::multimap<uint64_t,int>::iterator it=range.first; it != range.second; ++it) {
+                    const int r = it->second;
+                    if((rep < 0 || rep_rank[r] < rep_rank[rep]) &&
+                       matches(genotypes, founder_geno, mar, r, false))
+                        rep = r;
+                }
+            }
+            for(int j=0; j<n_miss; j++) anchor_geno[missing[j]] = 0;
+        }
+        else { // missing too many anchors: check all representatives
+            for(unsigned int j=0; j<reps.size() && rep < 0; j++) {
+                if(matches(genotypes, founder_geno, mar, reps[j], false))
+                    rep = reps[j];
+            }
+        }
+
+        if(rep < 0) { // new representative
+            rep = mar;
+            rep_rank[mar] = reps.size();
+            reps.push_back(mar);
+            for(int l=0; l<n_levels; l++) {
+                uint64_t h = fhash;
+                for(int a=0; a<levels[l]; a++) h = hash_value(h, anchor_geno[a]);
+                index[l].insert(std::make_pair(h, mar));
+            }
+        }
+        result[mar] = rep+1;
+    }
+}
+
+// find groups of markers with matching genotypes
+// [[Rcpp::export(".find_dup_markers")]]
+IntegerVector find_dup_markers(const IntegerMatrix& genotypes,
+                               const IntegerMatrix& founder_geno,
+                               const bool exact_only,
+                               const bool adjacent_only)
+{
+    const int n_ind = genotypes.rows();
+    const int n_mar = genotypes.cols();
+    if(founder_geno.rows() > 0 && founder_geno.cols() != n_mar)
+        throw std::invalid_argument("ncol(founder_geno) != ncol(genotypes)");
+
+    std::vector<int> n_typed(n_mar, 0);
+    for(int mar=0; mar<n_mar; mar++) {
+        const int* g = &genotypes[mar*n_ind];
+        for(int i=0; i<n_ind; i++) if(g[i] != 0) n_typed[mar]++;
+    }
+
+    IntegerVector result(n_mar); // 0 for markers with no data
+    if(adjacent_only)
+        find_dup_adjacent(genotypes, founder_geno, n_typed, exact_only, result);
+    else
+        find_dup_hashed(genotypes, founder_geno, n_typed, exact_only, result);
+
+    return result;
+}
+
+// find non-informative markers
+// [[Rcpp::export(".find_noninf_markers")]]
+IntegerVector find_noninf_markers(const IntegerMatrix& genotypes,
+                                  const IntegerMatrix& founder_geno)
+{
+    const int n_ind = genotypes.rows();
+    const int n_mar = genotypes.cols();
+    const int n_founders = founder_geno.rows();
+    if(n_founders > 0 && founder_geno.cols() != n_mar)
+        throw std::invalid_argument("ncol(founder_geno) != ncol(genotypes)");
+
+    IntegerVector result(n_mar);
+    for(int mar=0; mar<n_mar; mar++) {
+        const int* g = &genotypes[mar*n_ind];
+        bool any_typed = false;
+        for(int i=0; i<n_ind; i++) {
+            if(g[i] != 0) {
+                any_typed = true;
+                break;
+            }
+        }
+        if(!any_typed) {
+            result[mar] = 1;
+            continue;
+        }
+
+        if(n_founders > 0) {
+            // all missing, or none missing and all the same
+            int n_typed_founders = 0;
+            bool all_same = true;
+            for(int f=0; f<n_founders; f++) {
+                if(founder_geno(f,mar) != 0) n_typed_founders++;
+                if(founder_geno(f,mar) != founder_geno(0,mar)) all_same = false;
+            }
+            if(n_typed_founders == 0 || (n_typed_founders == n_founders && all_same))
+                result[mar] = 2;
+        }
+    }
+
+    return result;
+}
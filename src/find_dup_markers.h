@@ -0,0 +1,33 @@
+// find duplicate and non-informative markers
+#ifndef FIND_DUP_MARKERS_H
+#define FIND_DUP_MARKERS_H
+
+#include <Rcpp.h>
+
+// find groups of markers with matching genotypes
+//
+// genotypes     = matrix of observed genotypes (individuals x markers)
+// founder_geno  = matrix of founder genotypes (founders x markers); may have 0 rows
+// exact_only    = if true, only exact matches; otherwise a marker also matches another
+//                 marker that has the same genotypes wherever it is typed
+// adjacent_only = if true, only consider runs of adjacent markers
+//
+// output        = for each marker, the index (from 1) of the representative
+//                 marker for its group (itself, if it is a representative),
+//                 or 0 for markers with no genotype data
+Rcpp::IntegerVector find_dup_markers(const Rcpp::IntegerMatrix& genotypes,
+                                     const Rcpp::IntegerMatrix& founder_geno,
+                                     const bool exact_only,
+                                     const bool adjacent_only);
+
+// find non-informative markers
+//
+// genotypes     = matrix of observed genotypes (individuals x markers)
+// founder_geno  = matrix of founder genotypes (founders x markers); may have 0 rows
+//
+// output        = for each marker, 0 if informative, 1 if there is no genotype data,
+//                 or 2 if the founder genotypes are all missing or all the same
+Rcpp::IntegerVector find_noninf_markers(const Rcpp::IntegerMatrix& genotypes,
+                                        const Rcpp::IntegerMatrix& founder_geno);
+
+#endif // FIND_DUP_MARKERS_H
@@ -0,0 +1,114 @@
+// genomic prediction (GBLUP) with cross-validation
+//
+// With the eigen decomposition of the kinship matrix, K = U D U', the
+// inverse of the phenotype covariance matrix (up to a constant) is
+// P = [hsq K + (1-hsq) I]^{-1} = W'W, with W = diag(1/sqrt(hsq D + 1 - hsq)) U'.
+// When the individuals in T are held out, with S the rest, the inverse
+// covariance for the training set is obtained by downdating P:
+//     V_SS^{-1} = P_SS - P_ST P_TT^{-1} P_TS = W_S' (I - W_T P_TT^{-1} W_T') W_S
+// and the conditional mean for the held-out individuals is
+//     yhat_T = X_T b - P_TT^{-1} P_TS (y_S - X_S b)
+// where b is the GLS estimate from the training set. So each fold needs
+// only a Cholesky decomposition of P_TT, which is |T| x |T|, plus matrix
+// products that are done for all phenotypes at once.
+
+// [[Rcpp::depends(RcppEigen)]]
+
+#include "gblup.h"
+#include <math.h>
+#include <vector>
+#include <algorithm>
+#include <RcppEigen.h>
+
+using namespace Rcpp;
+using namespace Eigen;
+
+// cross-validated GBLUP predictions, for a fixed heritability
+// [[Rcpp::export]]
+NumericMatrix gblup_cv_pred(const NumericVector& Kva,
+                            const NumericMatrix& Kve,
+                            const NumericMatrix& Y,
+                            const NumericMatrix& X,
+                            const double hsq,
+                            const IntegerVector& fold)
+{
+    const int n_ind = Y.rows();
+    const int n_phe = Y.cols();
+    const int n_cov = X.cols();
+    if(Kva.size() != n_ind)
+        throw std::invalid_argument("length(Kva) != nrow(Y)");
+    if(Kve.rows() != n_ind || Kve.cols() != n_ind)
+        throw std::invalid_argument("Kve should be n_ind x n_ind");
+    if(X.rows() != n_ind)
+        throw std::invalid_argument("nrow(X) != nrow(Y)");
+    if(fold.size() != n_ind)
+        throw std::invalid_argument("length(fold) != nrow(Y)");
+    if(hsq < 0.0 || hsq >= 1.0)
+        throw std::invalid_argument("hsq should be in [0, 1)");
+
+    const Map<MatrixXd> YY(as<Map<MatrixXd> >(Y));
+    const Map<MatrixXd> XX(as<Map<MatrixXd> >(X));
+
+    // W = diag(1/sqrt(hsq D + 1 - hsq)) U'; columns are individuals
+    MatrixXd W(as<Map<MatrixXd> >(Kve));
+    for(int k=0; k<n_ind; k++)
+        W.row(k) /= sqrt(hsq*Kva[k] + 1.0 - hsq);
+
+    int n_fold = 0;
+    for(int i=0; i<n_ind; i++) {
+        if(fold[i] < 0 || fold[i] == NA_INTEGER)
+            throw std::invalid_argument("fold should be non-negative integers");
+        if(fold[i] > n_fold) n_fold = fold[i];
+    }
+
+    NumericMatrix result(n_ind, n_phe);
+    std::fill(result.begin(), result.end(), NA_REAL);
+
+    for(int f=1; f<=n_fold; f++) {
+        Rcpp::checkUserInterrupt();  // check for ^C from user
+
+        std::vector<int> test, train;
+        for(int i=0; i<n_ind; i++) {
+            if(fold[i] == f) test.push_back(i);
+            else train.push_back(i);
+        }
+        const int n_test = test.size(), n_train = train.size();
+        if(n_test == 0) continue;
+        if(n_train <= n_cov)
+            throw std::invalid_argument("Too few individuals in training set");
+
+        // pieces of W, X, and Y
+        MatrixXd W_T(n_ind, n_test), X_T(n_test, n_cov);
+        for(int i=0; i<n_test; i++) {
+            W_T.col(i) = W.col(test[i]);
+            X_T.row(i) = XX.row(test[i]);
+        }
+        MatrixXd W_S(n_ind, n_train), X_S(n_train, n_cov), Y_S(n_train, n_phe);
+        for(int i=0; i<n_train; i++) {
+            W_S.col(i) = W.col(train[i]);
+            X_S.row(i) = XX.row(train[i]);
+            Y_S.row(i) = YY.row(train[i]);
+        }
+        const MatrixXd BX = W_S * X_S;
+        const MatrixXd BY = W_S * Y_S;
+
+        // P_TT = W_T' W_T
+        const LLT<MatrixXd> PTT(W_T.transpose() * W_T);
+        if(PTT.info() != Success)
+            throw std::runtime_error("Cholesky decomposition failed");
+
+        // GLS estimates from training set
+        const MatrixXd MBX = BX - W_T * PTT.solve(W_T.transpose() * BX);
+        const MatrixXd XVX = BX.transpose() * MBX;
+        const MatrixXd XVY = MBX.transpose() * BY;
+        const MatrixXd b = XVX.ldlt().solve(XVY);
+
+        // predictions for test set
+        const MatrixXd pred = X_T * b - PTT.solve(W_T.transpose() * (BY - BX * b));
+        for(int i=0; i<n_test; i++)
+            for(int j=0; j<n_phe; j++)
+                result(test[i], j) = pred(i, j);
+    }
+
+    return result;
+}
@@ -0,0 +1,25 @@
+// genomic prediction (GBLUP) with cross-validation
+#ifndef GBLUP_H
+#define GBLUP_H
+
+#include <RcppEigen.h>
+
+// cross-validated GBLUP predictions, for a fixed heritability
+//
+// Kva    = eigenvalues of kinship matrix
+// Kve    = transposed eigenvectors of kinship matrix
+// Y      = matrix of phenotypes (individuals x phenotypes)
+// X      = matrix of covariates, including intercept
+// hsq    = heritability (used for all phenotypes)
+// fold   = integer vector of folds, 1..n_fold; 0 = always in training set
+//
+// output = matrix of predictions (individuals x phenotypes), with each
+//          individual predicted when its fold is held out; NA for fold 0
+Rcpp::NumericMatrix gblup_cv_pred(const Rcpp::NumericVector& Kva,
+                                  const Rcpp::NumericMatrix& Kve,
+                                  const Rcpp::NumericMatrix& Y,
+                                  const Rcpp::NumericMatrix& X,
+                                  const double hsq,
+                                  const Rcpp::IntegerVector& fold);
+
+#endif // GBLUP_H
@@ -0,0 +1,363 @@
+// run-length segments of imputed genotypes
+//
+// An imputed genome (e.g., from the Viterbi algorithm) is a mosaic of
+// a small number of segments on each chromosome. Storing the segments
+// (individual, start, end, genotype) rather than a genotype at every
+// marker takes far less space, and genotypes at any position can be
+// reconstructed as needed.
+
+#include "geno_segments.h"
+#include <vector>
+#include <algorithm>
+#include <Rcpp.h>
+#include "cross.h"
+
+using namespace Rcpp;
+
+// encode a matrix of imputed genotypes as run-length segments
+//
+// geno   = matrix of genotypes (individuals x positions); missing values break segments
+//
+// output = integer matrix (segments x 4) with columns individual index,
+//          index of first position, index of last position, and genotype
+//          (indexes starting at 1), sorted by individual and then by position
+//
+// [[Rcpp::export]]
+IntegerMatrix encode_geno_segments(const IntegerMatrix& geno)
+{
+    const int n_ind = geno.rows();
+    const int n_pos = geno.cols();
+
+    std::vector<int> seg_ind, seg_start, seg_end, seg_geno;
+
+    for(int ind=0; ind<n_ind; ind++) {
+        int start = -1;
+        for(int pos=0; pos<=n_pos; pos++) {
+            // end the current segment?
+            if(start >= 0 && (pos==n_pos || geno(ind,pos) != geno(ind,start))) {
+                seg_ind.push_back(ind+1);
+                seg_start.push_back(start+1);
+                seg_end.push_back(pos);
+                seg_geno.push_back(geno(ind,start));
+                start = -1;
+            }
+            if(pos < n_pos && start < 0 && geno(ind,pos) != NA_INTEGER)
+                start = pos;
+        }
+    }
+
+    const int n_seg = seg_ind.size();
+    IntegerMatrix result(n_seg, 4);
+    for(int i=0; i<n_seg; i++) {
+        result(i,0) = seg_ind[i];
+        result(i,1) = seg_start[i];
+        result(i,2) = seg_end[i];
+        result(i,3) = seg_geno[i];
+    }
+    colnames(result) = CharacterVector::create("ind", "start", "end", "geno");
+
+    return result;
+}
+
+// find the segment to use at each position, for each individual
+// (result is index of segment, or -1 if individual has no segments)
+static IntegerMatrix find_geno_segments(const IntegerVector& ind,
+                                        const NumericVector& start,
+                                        const NumericVector& end,
+                                        const int n_ind,
+                                        const NumericVector& pos)
+{
+    const int n_seg = ind.size();
+    const int n_pos = pos.size();
+    if(start.size() != n_seg)
+        throw std::invalid_argument("length(start) != length(ind)");
+    if(end.size() != n_seg)
+        throw std::invalid_argument("length(end) != length(ind)");
+    for(int i=1; i<n_pos; i++)
+        if(pos[i] < pos[i-1])
+            throw std::invalid_argument("pos should be sorted");
+    for(int i=1; i<n_seg; i++) {
+        if(ind[i] < ind[i-1] || (ind[i]==ind[i-1] && start[i] < start[i-1]))
+            throw std::invalid_argument("segments should be sorted by individual and position");
+    }
+
+    IntegerMatrix result(n_ind, n_pos);
+    std::fill(result.begin(), result.end(), -1);
+
+    for(int seg=0; seg<n_seg; ) {
+        const int this_ind = ind[seg]-1;
+        if(this_ind < 0 || this_ind >= n_ind)
+            throw std::range_error("ind out of range");
+
+        // segments for this individual
+        int last = seg;
+        while(last+1 < n_seg && ind[last+1]==ind[seg]) last++;
+
+        // merge-join of positions and segments
+        int s = seg;
+        for(int p=0; p<n_pos; p++) {
+            // last segment starting at or before this position
+            while(s < last && start[s+1] <= pos[p]) s++;
+
+            // in the gap between segments s and s+1? use the nearer one
+            if(s < last && pos[p] > end[s] && start[s+1] - pos[p] < pos[p] - end[s])
+                result(this_ind, p) = s+1;
+            else
+                result(this_ind, p) = s;
+        }
+
+        seg = last+1;
+    }
+
+    return result;
+}
+
+// decode run-length segments to genotypes at arbitrary positions
+//
+// ind    = individual index for each segment (starting at 1)
+// start  = start position of each segment
+// end    = end position of each segment
+// geno   = genotype for each segment
+// n_ind  = number of individuals
+// pos    = positions at which to get genotypes (sorted)
+//
+// output = integer matrix of genotypes (individuals x positions)
+//
+// [[Rcpp::export]]
+IntegerMatrix decode_geno_segments(const IntegerVector& ind,
+                                   const NumericVector& start,
+                                   const NumericVector& end,
+                                   const IntegerVector& geno,
+                                   const int n_ind,
+                                   const NumericVector& pos)
+{
+    if(geno.size() != ind.size())
+        throw std::invalid_argument("length(geno) != length(ind)");
+
+    const IntegerMatrix seg = find_geno_segments(ind, start, end, n_ind, pos);
+
+    IntegerMatrix result(n_ind, pos.size());
+    for(int i=0; i<seg.size(); i++) {
+        if(seg[i] < 0) result[i] = NA_INTEGER;
+        else result[i] = geno[seg[i]];
+    }
+
+    return result;
+}
+
+// decode run-length segments to allele probabilities at arbitrary positions
+//
+// crosstype = type of cross
+// ind, start, end, geno, n_ind, pos = as for decode_geno_segments
+// n_gen     = number of genotypes
+// is_x_chr  = whether this is the X chromosome
+//
+// output    = 3d array (individuals x alleles x positions) of allele
+//             dosages divided by 2 (or 0/1 genotype indicators, if
+//             there is no conversion from genotypes to alleles)
+//
+// [[Rcpp::export]]
+NumericVector decode_geno_segments_alleleprob(const String& crosstype,
+                                              const IntegerVector& ind,
+                                              const NumericVector& start,
+                                              const NumericVector& end,
+                                              const IntegerVector& geno,
+                                              const int n_ind,
+                                              const NumericVector& pos,
+                                              const int n_gen,
+                                              const bool is_x_chr)
+{
+    if(geno.size() != ind.size())
+        throw std::invalid_argument("length(geno) != length(ind)");
+    const int n_pos = pos.size();
+
+    QTLCross* cross = QTLCross::Create(crosstype);
+    const NumericMatrix transform = cross->geno2allele_matrix(is_x_chr);
+    delete cross;
+    const bool convert = (transform.cols() > 0);
+    const int n_allele = convert ? transform.cols() : n_gen;
+    if(convert && transform.rows() != n_gen)
+        throw std::invalid_argument("n_gen doesn't match no. rows in transform matrix");
+
+    const IntegerMatrix seg = find_geno_segments(ind, start, end, n_ind, pos);
+
+    NumericVector result(n_ind*n_allele*n_pos);
+    for(int p=0; p<n_pos; p++) {
+        Rcpp::checkUserInterrupt();  // check for ^C from user
+
+        for(int i=0; i<n_ind; i++) {
+            const int offset = i + p*n_ind*n_allele;
+            if(seg(i,p) < 0) { // no segments: missing
+                for(int a=0; a<n_allele; a++) result[offset + a*n_ind] = NA_REAL;
+                continue;
+            }
+            const int g = geno[seg(i,p)] - 1;
+            if(g < 0 || g >= n_gen)
+                throw std::range_error("geno out of range");
+
+            if(convert) {
+                for(int a=0; a<n_allele; a++) result[offset + a*n_ind] = transform(g,a);
+            }
+            else result[offset + g*n_ind] = 1.0;
+        }
+    }
+    result.attr("dim") = Dimension(n_ind, n_allele, n_pos);
+
+    return result;
+}
+
+// kinship from run-length segments, summed over a set of positions
+//
+// crosstype, ind, start, end, geno, n_ind, pos, n_gen, is_x_chr = as for
+//             decode_geno_segments_alleleprob
+// use_allele_probs = if true, compare allele dosages (if the cross type
+//             converts genotypes to alleles); otherwise compare genotypes
+//
+// output    = matrix (individuals x individuals) with the sum over positions
+//             of the similarity of each pair of individuals, as with
+//             calc_kinship on the decoded probabilities (not scaled by the
+//             number of positions)
+//
+// The genotypes are reconstructed one position at a time, keeping just the
+// current segment for each individual. The contribution of a pair of
+// individuals is added when either one changes genotype, so the time is
+// proportional to the number of changes times the number of individuals.
+//
+// [[Rcpp::export]]
+NumericMatrix calc_kinship_segments(const String& crosstype,
+                                    const IntegerVector& ind,
+                                    const NumericVector& start,
+                                    const NumericVector& end,
+                                    const IntegerVector& geno,
+                                    const int n_ind,
+                                    const NumericVector& pos,
+                                    const int n_gen,
+                                    const bool is_x_chr,
+                                    const bool use_allele_probs)
+{
+    const int n_seg = ind.size();
+    const int n_pos = pos.size();
+    if(geno.size() != n_seg)
+        throw std::invalid_argument("length(geno) != length(ind)");
+    if(start.size() != n_seg)
+        throw std::invalid_argument("length(start) != length(ind)");
+    if(end.size() != n_seg)
+        throw std::invalid_argument("length(end) != length(ind)");
+    for(int i=1; i<n_pos; i++)
+        if(pos[i] < pos[i-1])
+            throw std::invalid_argument("pos should be sorted");
+    for(int i=1; i<n_seg; i++) {
+        if(ind[i] < ind[i-1] || (ind[i]==ind[i-1] && start[i] < start[i-1]))
+            throw std::invalid_argument("segments should be sorted by individual and position");
+    }
+    for(int i=0; i<n_seg; i++) {
+        if(ind[i] < 1 || ind[i] > n_ind)
+            throw std::range_error("ind out of range");
+        if(geno[i] < 1 || geno[i] > n_gen)
+            throw std::range_error("geno out of range");
+    }
+
+    // similarity of each pair of genotypes
+    NumericMatrix sim(n_gen, n_gen);
+    NumericMatrix transform(0,0);
+    if(use_allele_probs) {
+        QTLCross* cross = QTLCross::Create(crosstype);
+        transform = cross->geno2allele_matrix(is_x_chr);
+        delete cross;
+    }
+    if(transform.cols() > 0) {
+        if(transform.rows() != n_gen)
+            throw std::invalid_argument("n_gen doesn't match no. rows in transform matrix");
+        for(int g1=0; g1<n_gen; g1++) {
+            for(int g2=0; g2<n_gen; g2++) {
+                for(int a=0; a<transform.cols(); a++)
+                    sim(g1,g2) += transform(g1,a)*transform(g2,a);
+            }
+        }
+    }
+    else {
+        for(int g=0; g<n_gen; g++) sim(g,g) = 1.0;
+    }
+
+    // first and last segment for each individual (-1 if none)
+    std::vector<int> first(n_ind, -1), last(n_ind, -1);
+    for(int s=0; s<n_seg; s++) {
+        const int i = ind[s]-1;
+        if(first[i] < 0) first[i] = s;
+        last[i] = s;
+    }
+
+    NumericMatrix result(n_ind, n_ind);
+    if(n_pos == 0) return result;
+
+    std::vector<int> cur_seg(first);      // current segment
+    std::vector<int> cur_geno(n_ind, -1);  // current genotype (from 0)
+    std::vector<int> since(n_ind, 0);      // position index where current genotype started
+    std::vector<int> change_rank(n_ind, -1);
+    std::vector<int> changed, new_geno;
+
+    for(int p=0; p<n_pos; p++) {
+        Rcpp::checkUserInterrupt();  // check for ^C from user
+
+        // find the genotype at this position for each individual
+        changed.clear();
+        new_geno.clear();
+        for(int i=0; i<n_ind; i++) {
+            if(first[i] < 0) continue;
+
+            // last segment starting at or before this position
+            int& s = cur_seg[i];
+            while(s < last[i] && start[s+1] <= pos[p]) s++;
+
+            // in the gap between segments s and s+1? use the nearer one
+            int g;
+            if(s < last[i] && pos[p] > end[s] && start[s+1] - pos[p] < pos[p] - end[s])
+                g = geno[s+1]-1;
+            else
+                g = geno[s]-1;
+
+            if(p==0) cur_geno[i] = g;
+            else if(g != cur_geno[i]) {
+                change_rank[i] = changed.size();
+                changed.push_back(i);
+                new_geno.push_back(g);
+            }
+        }
+
+        // add the contributions of the pairs involving individuals that changed
+        for(unsigned int k=0; k<changed.size(); k++) {
+            const int i = changed[k];
+            for(int j=0; j<n_ind; j++) {
+                if(first[j] < 0) continue;
+                if(change_rank[j] >= 0 && change_rank[j] < (int)k) continue; // already done
+                const int n = p - std::max(since[i], since[j]);
+                const double value = sim(cur_geno[i], cur_geno[j]) * n;
+                result(i,j) += value;
+                if(j != i) result(j,i) += value;
+            }
+        }
+
+        for(unsigned int k=0; k<changed.size(); k++) {
+            const int i = changed[k];
+            cur_geno[i] = new_geno[k];
+            since[i] = p;
+            change_rank[i] = -1;
+        }
+    }
+
+    // the remaining contributions, and missing values for individuals with no segments
+    for(int i=0; i<n_ind; i++) {
+        for(int j=i; j<n_ind; j++) {
+            if(first[i] < 0 || first[j] < 0) {
+                result(i,j) = result(j,i) = NA_REAL;
+                continue;
+            }
+            const int n = n_pos - std::max(since[i], since[j]);
+            const double value = sim(cur_geno[i], cur_geno[j]) * n;
+            result(i,j) += value;
+            if(j != i) result(j,i) += value;
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,79 @@
+// run-length segments of imputed genotypes
+#ifndef GENO_SEGMENTS_H
+#define GENO_SEGMENTS_H
+
+#include <Rcpp.h>
+
+// encode a matrix of imputed genotypes as run-length segments
+//
+// geno   = matrix of genotypes (individuals x positions); missing values break segments
+//
+// output = integer matrix (segments x 4) with columns individual index,
+//          index of first position, index of last position, and genotype
+//          (indexes starting at 1), sorted by individual and then by position
+Rcpp::IntegerMatrix encode_geno_segments(const Rcpp::IntegerMatrix& geno);
+
+// decode run-length segments to genotypes at arbitrary positions
+//
+// ind    = individual index for each segment (starting at 1)
+// start  = start position of each segment
+// end    = end position of each segment
+// geno   = genotype for each segment
+// n_ind  = number of individuals
+// pos    = positions at which to get genotypes (sorted)
+//
+// output = integer matrix of genotypes (individuals x positions)
+//
+// Segments should be sorted by individual and then by position.
+// Positions between two segments are assigned the genotype of the nearer
+// segment; positions beyond the ends take the genotype of the first or last.
+Rcpp::IntegerMatrix decode_geno_segments(const Rcpp::IntegerVector& ind,
+                                         const Rcpp::NumericVector& start,
+                                         const Rcpp::NumericVector& end,
+                                         const Rcpp::IntegerVector& geno,
+                                         const int n_ind,
+                                         const Rcpp::NumericVector& pos);
+
+// decode run-length segments to allele probabilities at arbitrary positions
+//
+// crosstype = type of cross
+// ind, start, end, geno, n_ind, pos = as for decode_geno_segments
+// n_gen     = number of genotypes
+// is_x_chr  = whether this is the X chromosome
+//
+// output    = 3d array (individuals x alleles x positions) of allele
+//             dosages divided by 2 (or 0/1 genotype indicators, if
+//             there is no conversion from genotypes to alleles)
+Rcpp::NumericVector decode_geno_segments_alleleprob(const Rcpp::String& crosstype,
+                                                    const Rcpp::IntegerVector& ind,
+                                                    const Rcpp::NumericVector& start,
+                                                    const Rcpp::NumericVector& end,
+                                                    const Rcpp::IntegerVector& geno,
+                                                    const int n_ind,
+                                                    const Rcpp::NumericVector& pos,
+                                                    const int n_gen,
+                                                    const bool is_x_chr);
+
+// kinship from run-length segments, summed over a set of positions
+//
+// crosstype, ind, start, end, geno, n_ind, pos, n_gen, is_x_chr = as for
+//             decode_geno_segments_alleleprob
+// use_allele_probs = if true, compare allele dosages (if the cross type
+//             converts genotypes to alleles); otherwise compare genotypes
+//
+// output    = matrix (individuals x individuals) with the sum over positions
+//             of the similarity of each pair of individuals, as with
+//             calc_kinship on the decoded probabilities (not scaled by the
+//             number of positions)
+Rcpp::NumericMatrix calc_kinship_segments(const Rcpp::String& crosstype,
+                                          const Rcpp::IntegerVector& ind,
+                                          const Rcpp::NumericVector& start,
+                                          const Rcpp::NumericVector& end,
+                                          const Rcpp::IntegerVector& geno,
+                                          const int n_ind,
+                                          const Rcpp::NumericVector& pos,
+                                          const int n_gen,
+                                          const bool is_x_chr,
+                                          const bool use_allele_probs);
+
+#endif // GENO_SEGMENTS_H
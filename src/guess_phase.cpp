@@ -229,3 +229,165 @@ IntegerVector phase_geno(IntegerVector g1, IntegerVector g2,
 
     return result;
 }
+
+
+// guess phase of imputed genotypes, returned as run-length segments
+// [[Rcpp::export(".guess_phase_segments")]]
+IntegerMatrix guess_phase_segments(const IntegerVector& geno, // ind x pos x draws
+                                   const String& crosstype,
+                                   const bool is_x_chr,
+                                   const LogicalVector& is_female,
+                                   const bool deterministic)
+{
+    if(Rf_isNull(geno.attr("dim")))
+        throw std::invalid_argument("geno should be a 3d array but has no dim attribute");
+    const Dimension d = geno.attr("dim");
+    if(d.size() != 3)
+        throw std::invalid_argument("geno should be a 3d array");
+    const int n_ind = d[0];
+    const int n_pos = d[1];
+    const int n_draws = d[2];
+    if(is_x_chr && is_female.size() != n_ind)
+        throw std::invalid_argument("length(is_female) != nrow(geno)");
+
+    // lookup tables of genotype code -> pair of alleles, for females and males
+    // (fixed = phase is known, as for male X chr, so no need to guess)
+    const bool is_f2 = (crosstype == "f2");
+    QTLCross* cross = QTLCross::Create(crosstype);
+    const int n_gen_A = cross->ngen(false);
+    const int n_gen = cross->ngen(is_x_chr);
+    const int n_alleles = cross->nalleles();
+    delete cross;
+
+    std::vector<int> allele1_f(n_gen+1, NA_INTEGER), allele2_f(n_gen+1, NA_INTEGER);
+    std::vector<int> allele1_m(n_gen+1, NA_INTEGER), allele2_m(n_gen+1, NA_INTEGER);
+    bool fixed_f = false, fixed_m = false;
+    if(is_f2 && is_x_chr) { // genotypes are already phase-known
+        const int a1[6] = {1, 2, 1, 2, 1, 2};
+        const int a2[6] = {1, 1, 2, 2, NA_INTEGER, NA_INTEGER};
+        for(int g=1; g<=6 && g<=n_gen; g++) {
+            allele1_f[g] = allele1_m[g] = a1[g-1];
+            allele2_f[g] = allele2_m[g] = a2[g-1];
+        }
+        fixed_f = fixed_m = true;
+    }
+    else if(is_f2) {
+        allele1_f[1] = allele2_f[1] = 1;
+        allele1_f[2] = 1; allele2_f[2] = 2;
+        allele1_f[3] = allele2_f[3] = 2;
+        allele1_m = allele1_f;
+        allele2_m = allele2_f;
+    }
+    else {
+        for(int g=1; g<=n_gen_A; g++) {
+            IntegerVector a = mpp_decode_geno(g, n_alleles, false);
+            allele1_f[g] = a[0];
+            allele2_f[g] = a[1];
+        }
+        if(is_x_chr) { // males are hemizygous
+            for(int g=n_gen_A+1; g<=n_gen; g++)
+                allele1_m[g] = g - n_gen_A;
+            fixed_m = true;
+        }
+        else {
+            allele1_m = allele1_f;
+            allele2_m = allele2_f;
+        }
+    }
+
+    // phasing state and open segments for each individual (within a draw)
+    std::vector<int> cur1(n_ind), cur2(n_ind);
+    std::vector<int> seg_start(n_ind*2), seg_allele(n_ind*2);
+    std::vector<int> out_key, out_start, out_end, out_allele;
+
+    for(int draw=0; draw<n_draws; draw++) {
+        Rcpp::checkUserInterrupt();  // check for ^C from user
+
+        std::fill(cur1.begin(), cur1.end(), NA_INTEGER);
+        std::fill(cur2.begin(), cur2.end(), NA_INTEGER);
+        std::fill(seg_start.begin(), seg_start.end(), -1);
+
+        for(int pos=0; pos<=n_pos; pos++) {
+            const int* g = (pos < n_pos) ? &(geno[(draw*n_pos + pos)*n_ind]) : 0;
+
+            for(int ind=0; ind<n_ind; ind++) {
+                int h[2] = {NA_INTEGER, NA_INTEGER};
+
+                if(pos < n_pos) {
+                    const bool male = is_x_chr && !is_female[ind];
+                    const int gg = g[ind];
+                    if(gg != NA_INTEGER && gg > 0 && gg <= n_gen) {
+                        const int a1 = male ? allele1_m[gg] : allele1_f[gg];
+                        const int a2 = male ? allele2_m[gg] : allele2_f[gg];
+
+                        if(male ? fixed_m : fixed_f) {
+                            h[0] = a1;
+                            h[1] = a2;
+                        }
+                        else if(a1 == NA_INTEGER || a2 == NA_INTEGER) {
+                            // missing; leave as NA
+                        }
+                        else if(a1 == a2) { // homozygous so no need to guess
+                            h[0] = h[1] = cur1[ind] = cur2[ind] = a1;
+                        }
+                        else { // same logic as phase_geno()
+                            bool flip;
+                            if(cur1[ind] == NA_INTEGER || cur2[ind] == NA_INTEGER)
+                                flip = !((deterministic && cur1[ind] <= cur2[ind]) ||
+                                         (!deterministic && R::runif(0.0, 1.0) < 0.5));
+                            else if(cur1[ind] == a1 || cur2[ind] == a2)
+                                flip = false;
+                            else if(cur2[ind] == a1 || cur1[ind] == a2)
+                                flip = true;
+                            else
+                                flip = !((deterministic && cur1[ind] <= cur2[ind]) ||
+                                         (!deterministic && R::runif(0.0, 1.0) < 0.5));
+
+                            h[0] = cur1[ind] = flip ? a2 : a1;
+                            h[1] = cur2[ind] = flip ? a1 : a2;
+                        }
+                    }
+                }
+
+                // close or start segments
+                for(int hap=0; hap<2; hap++) {
+                    const int k = ind*2 + hap;
+                    if(seg_start[k] >= 0 && h[hap] != seg_allele[k]) {
+                        out_key.push_back((ind*n_draws + draw)*2 + hap);
+                        out_start.push_back(seg_start[k]+1);
+                        out_end.push_back(pos);
+                        out_allele.push_back(seg_allele[k]);
+                        seg_start[k] = -1;
+                    }
+                    if(seg_start[k] < 0 && h[hap] != NA_INTEGER) {
+                        seg_start[k] = pos;
+                        seg_allele[k] = h[hap];
+                    }
+                }
+            }
+        }
+    }
+
+    // counting sort by individual, draw, and haplotype
+    // (within each, the segments are already in order of position)
+    const int n_keys = n_ind*n_draws*2;
+    const int n_seg = out_key.size();
+    std::vector<int> key_start(n_keys+1, 0);
+    for(int i=0; i<n_seg; i++) key_start[out_key[i]+1]++;
+    for(int k=0; k<n_keys; k++) key_start[k+1] += key_start[k];
+
+    IntegerMatrix result(n_seg, 6);
+    for(int i=0; i<n_seg; i++) {
+        const int key = out_key[i];
+        const int row = key_start[key]++;
+        result(row,0) = key/(n_draws*2) + 1;
+        result(row,1) = (key/2) % n_draws + 1;
+        result(row,2) = key % 2 + 1;
+        result(row,3) = out_start[i];
+        result(row,4) = out_end[i];
+        result(row,5) = out_allele[i];
+    }
+    colnames(result) = CharacterVector::create("ind", "draw", "hap", "start", "end", "allele");
+
+    return result;
+}
@@ -26,6 +26,23 @@ Rcpp::IntegerVector guess_phase_X(const Rcpp::IntegerMatrix& geno, // pos x ind
                                   bool deterministic);
 
 
+// guess phase of imputed genotypes, returned as run-length segments
+//
+// geno      = 3d array of imputed genotypes (individuals x positions x draws)
+// crosstype = type of cross
+// is_x_chr  = whether this is the X chromosome
+// is_female = logical vector indicating females (used only for X chr)
+//
+// output = integer matrix (segments x 6) with columns individual index,
+//          draw, haplotype (1/2), index of first position, index of last
+//          position, and allele (indexes starting at 1), sorted by
+//          individual, draw, haplotype, and then position
+Rcpp::IntegerMatrix guess_phase_segments(const Rcpp::IntegerVector& geno,
+                                         const Rcpp::String& crosstype,
+                                         const bool is_x_chr,
+                                         const Rcpp::LogicalVector& is_female,
+                                         const bool deterministic);
+
 // guess phase of genotypes for one individual along one chromosome
 Rcpp::IntegerVector phase_geno(Rcpp::IntegerVector g1, Rcpp::IntegerVector g2,
                                bool deterministic);
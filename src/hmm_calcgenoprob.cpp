@@ -17,11 +17,13 @@ NumericVector calc_genoprob(const String& crosstype,
                             const IntegerMatrix& cross_info, // columns are individuals
                             const NumericVector& rec_frac,   // length nrow(genotypes)-1
                             const IntegerVector& marker_index, // length nrow(genotypes)
-                            const double error_prob)
+                            const double error_prob,
+                            const IntegerVector& out_index) // positions to output (starting at 0)
 {
     const int n_ind = genotypes.cols();
     const int n_pos = marker_index.size();
     const int n_mar = genotypes.rows();
+    const int n_out_pos = out_index.size();
 
     QTLCross* cross = QTLCross::Create(crosstype);
 
@@ -32,6 +34,7 @@ NumericVector calc_genoprob(const String& crosstype,
         throw std::range_error("ncols(cross_info) != ncol(genotypes)");
     if(rec_frac.size() != n_pos-1)
         throw std::range_error("length(rec_frac) != length(marker_index)-1");
+    check_out_index(out_index, n_pos);
 
     if(error_prob < 0.0 || error_prob > 1.0)
         throw std::range_error("error_prob out of range");
@@ -46,7 +49,7 @@ NumericVector calc_genoprob(const String& crosstype,
 
     const int n_gen = cross->ngen(is_X_chr);
     const int matsize = n_gen*n_ind; // size of genotype x individual matrix
-    NumericVector genoprobs(matsize*n_pos);
+    NumericVector genoprobs(matsize*n_out_pos);
 
     for(int ind=0; ind<n_ind; ind++) {
 
@@ -65,7 +68,9 @@ NumericVector calc_genoprob(const String& crosstype,
                                                poss_gen);
 
         // calculate genotype probabilities
-        for(int pos=0, matindex=n_gen*ind; pos<n_pos; pos++, matindex += matsize) {
+        // (only at the output positions)
+        for(int j=0, matindex=n_gen*ind; j<n_out_pos; j++, matindex += matsize) {
+            const int pos = out_index[j];
             int g = poss_gen[0]-1;
             double sum_at_pos = genoprobs[matindex+g] = alpha(0,pos) + beta(0,pos);
             for(int i=1; i<n_poss_gen; i++) {
@@ -80,7 +85,7 @@ NumericVector calc_genoprob(const String& crosstype,
         }
     } // loop over individuals
 
-    genoprobs.attr("dim") = Dimension(n_gen, n_ind, n_pos);
+    genoprobs.attr("dim") = Dimension(n_gen, n_ind, n_out_pos);
     delete cross;
     return genoprobs;
 }
@@ -12,6 +12,7 @@ Rcpp::NumericVector calc_genoprob(const Rcpp::String& crosstype,
                                   const Rcpp::IntegerMatrix& cross_info, // columns are individuals
                                   const Rcpp::NumericVector& rec_frac,   // length nrow(genotypes)-1
                                   const Rcpp::IntegerVector& marker_index, // length nrow(genotypes)
-                                  const double error_prob);
+                                  const double error_prob,
+                                  const Rcpp::IntegerVector& out_index); // positions to output (starting at 0)
 
 #endif // HMM_CALCGENOPROB_H
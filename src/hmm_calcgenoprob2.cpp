@@ -8,27 +8,32 @@
 #include "hmm_util.h"
 #include "hmm_forwback2.h"
 
-// calculate conditional genotype probabilities given multipoint marker data
-// [[Rcpp::export(".calc_genoprob2")]]
-NumericVector calc_genoprob2(const String& crosstype,
-                             const IntegerMatrix& genotypes, // columns are individuals, rows are markers
-                             const IntegerMatrix& founder_geno, // columns are markers, rows are founder lines
-                             const bool is_X_chr,
-                             const bool is_female, // same for all individuals
-                             const IntegerVector& cross_info, // same for all individuals
-                             const NumericVector& rec_frac,   // length nrow(genotypes)-1
-                             const IntegerVector& marker_index, // length nrow(genotypes)
-                             const double error_prob)
+// calculate conditional genotype or allele probabilities given multipoint marker data
+// (if to_alleles, genotype probabilities are collapsed to allele probabilities
+//  for each individual and position, so the full genotype array is never formed)
+static NumericVector calc_genoprob2_internal(const String& crosstype,
+                                             const IntegerMatrix& genotypes,
+                                             const IntegerMatrix& founder_geno,
+                                             const bool is_X_chr,
+                                             const bool is_female,
+                                             const IntegerVector& cross_info,
+                                             const NumericVector& rec_frac,
+                                             const IntegerVector& marker_index,
+                                             const double error_prob,
+                                             const IntegerVector& out_index,
+                                             const bool to_alleles)
 {
     const int n_ind = genotypes.cols();
     const int n_pos = marker_index.size();
     const int n_mar = genotypes.rows();
+    const int n_out_pos = out_index.size();
 
     QTLCross* cross = QTLCross::Create(crosstype);
 
     // check inputs
     if(rec_frac.size() != n_pos-1)
         throw std::range_error("length(rec_frac) != length(marker_index)-1");
+    check_out_index(out_index, n_pos);
 
     if(error_prob < 0.0 || error_prob > 1.0)
         throw std::range_error("error_prob out of range");
@@ -44,8 +49,17 @@ NumericVector calc_genoprob2(const String& crosstype,
     // end of checks
 
     const int n_gen = cross->ngen(is_X_chr);
-    const int matsize = n_gen*n_ind; // size of genotype x individual matrix
-    NumericVector genoprobs(matsize*n_pos);
+
+    // genotype -> allele transformation (no columns = no conversion)
+    NumericMatrix transform;
+    if(to_alleles) transform = cross->geno2allele_matrix(is_X_chr);
+    const bool convert = (transform.cols() > 0);
+    if(convert && transform.rows() != n_gen)
+        throw std::invalid_argument("no. genotypes doesn't match no. rows in geno2allele matrix");
+    const int n_out = convert ? transform.cols() : n_gen;
+
+    const int matsize = n_out*n_ind; // size of genotype (or allele) x individual matrix
+    NumericVector genoprobs(matsize*n_out_pos);
 
     NumericVector init_vector = cross->calc_initvector(is_X_chr, is_female, cross_info);
 
@@ -61,6 +75,22 @@ NumericVector calc_genoprob2(const String& crosstype,
     IntegerVector poss_gen = cross->possible_gen(is_X_chr, is_female, cross_info);
     const int n_poss_gen = poss_gen.size();
 
+    // non-zero entries in transform, for each possible genotype
+    std::vector< std::vector<int> > trans_allele(n_poss_gen);
+    std::vector< std::vector<double> > trans_value(n_poss_gen);
+    if(convert) {
+        for(int i=0; i<n_poss_gen; i++) {
+            for(int j=0; j<n_out; j++) {
+                const double v = transform(poss_gen[i]-1, j);
+                if(v != 0.0) {
+                    trans_allele[i].push_back(j);
+                    trans_value[i].push_back(v);
+                }
+            }
+        }
+    }
+    std::vector<double> pr(n_poss_gen);
+
     for(int ind=0; ind<n_ind; ind++) {
 
         Rcpp::checkUserInterrupt();  // check for ^C from user
@@ -70,22 +100,64 @@ NumericVector calc_genoprob2(const String& crosstype,
         NumericMatrix beta = backwardEquations2(genotypes(_,ind), init_vector, emit_matrix, step_matrix, marker_index, poss_gen);
 
         // calculate genotype probabilities
-        for(int pos=0, matindex=n_gen*ind; pos<n_pos; pos++, matindex += matsize) {
-            int g = poss_gen[0]-1;
-            double sum_at_pos = genoprobs[matindex+g] = alpha(0,pos) + beta(0,pos);
+        // (only at the output positions)
+        for(int j=0, matindex=n_out*ind; j<n_out_pos; j++, matindex += matsize) {
+            const int pos = out_index[j];
+            double sum_at_pos = pr[0] = alpha(0,pos) + beta(0,pos);
             for(int i=1; i<n_poss_gen; i++) {
-                int g = poss_gen[i]-1;
-                double val = genoprobs[matindex+g] = alpha(i,pos) + beta(i,pos);
-                sum_at_pos = addlog(sum_at_pos, val);
+                pr[i] = alpha(i,pos) + beta(i,pos);
+                sum_at_pos = addlog(sum_at_pos, pr[i]);
+            }
+
+            if(convert) { // collapse to alleles
+                for(int i=0; i<n_poss_gen; i++) {
+                    const double p = exp(pr[i] - sum_at_pos);
+                    for(int k=0; k<(int)trans_allele[i].size(); k++)
+                        genoprobs[matindex+trans_allele[i][k]] += p*trans_value[i][k];
+                }
             }
-            for(int i=0; i<n_poss_gen; i++) {
-                int g = poss_gen[i]-1;
-                genoprobs[matindex+g] = exp(genoprobs[matindex+g] - sum_at_pos);
+            else {
+                for(int i=0; i<n_poss_gen; i++)
+                    genoprobs[matindex+poss_gen[i]-1] = exp(pr[i] - sum_at_pos);
             }
         }
     } // loop over individuals
 
-    genoprobs.attr("dim") = Dimension(n_gen, n_ind, n_pos);
+    genoprobs.attr("dim") = Dimension(n_out, n_ind, n_out_pos);
     delete cross;
     return genoprobs;
 }
+
+// calculate conditional genotype probabilities given multipoint marker data
+// [[Rcpp::export(".calc_genoprob2")]]
+NumericVector calc_genoprob2(const String& crosstype,
+                             const IntegerMatrix& genotypes, // columns are individuals, rows are markers
+                             const IntegerMatrix& founder_geno, // columns are markers, rows are founder lines
+                             const bool is_X_chr,
+                             const bool is_female, // same for all individuals
+                             const IntegerVector& cross_info, // same for all individuals
+                             const NumericVector& rec_frac,   // length nrow(genotypes)-1
+                             const IntegerVector& marker_index, // length nrow(genotypes)
+                             const double error_prob,
+                             const IntegerVector& out_index) // positions to output (starting at 0)
+{
+    return calc_genoprob2_internal(crosstype, genotypes, founder_geno, is_X_chr, is_female,
+                                   cross_info, rec_frac, marker_index, error_prob, out_index, false);
+}
+
+// calculate conditional allele probabilities given multipoint marker data
+// [[Rcpp::export(".calc_alleleprob2")]]
+NumericVector calc_alleleprob2(const String& crosstype,
+                               const IntegerMatrix& genotypes, // columns are individuals, rows are markers
+                               const IntegerMatrix& founder_geno, // columns are markers, rows are founder lines
+                               const bool is_X_chr,
+                               const bool is_female, // same for all individuals
+                               const IntegerVector& cross_info, // same for all individuals
+                               const NumericVector& rec_frac,   // length nrow(genotypes)-1
+                               const IntegerVector& marker_index, // length nrow(genotypes)
+                               const double error_prob,
+                               const IntegerVector& out_index) // positions to output (starting at 0)
+{
+    return calc_genoprob2_internal(crosstype, genotypes, founder_geno, is_X_chr, is_female,
+                                   cross_info, rec_frac, marker_index, error_prob, out_index, true);
+}
@@ -13,6 +13,21 @@ Rcpp::NumericVector calc_genoprob2(const Rcpp::String& crosstype,
                                    const Rcpp::IntegerVector& cross_info, // same for all individuals
                                    const Rcpp::NumericVector& rec_frac,   // length nrow(genotypes)-1
                                    const Rcpp::IntegerVector& marker_index, // length nrow(genotypes)
-                                   const double error_prob);
+                                   const double error_prob,
+                                   const Rcpp::IntegerVector& out_index); // positions to output (starting at 0)
+
+// calculate conditional allele probabilities given multipoint marker data
+// (same as calc_genoprob2 but with genotype probabilities collapsed to allele
+//  probabilities within the loop over individuals; output is n_allele x n_ind x n_pos)
+Rcpp::NumericVector calc_alleleprob2(const Rcpp::String& crosstype,
+                                     const Rcpp::IntegerMatrix& genotypes, // columns are individuals, rows are markers
+                                     const Rcpp::IntegerMatrix& founder_geno, // columns are markers, rows are founder lines
+                                     const bool is_X_chr,
+                                     const bool is_female, // same for all individuals
+                                     const Rcpp::IntegerVector& cross_info, // same for all individuals
+                                     const Rcpp::NumericVector& rec_frac,   // length nrow(genotypes)-1
+                                     const Rcpp::IntegerVector& marker_index, // length nrow(genotypes)
+                                     const double error_prob,
+                                     const Rcpp::IntegerVector& out_index); // positions to output (starting at 0)
 
 #endif // HMM_CALCGENOPROB2_H
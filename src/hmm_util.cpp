@@ -24,3 +24,16 @@ double subtractlog(const double a, const double b)
     if(a > b + tol) return a;
     else return a + log1p(-exp(b-a));
 }
+
+// check index of positions at which to output probabilities
+// (should be increasing, and within 0, ..., n_pos-1)
+void check_out_index(const Rcpp::IntegerVector& out_index, const int n_pos)
+{
+    const int n = out_index.size();
+    for(int i=0; i<n; i++) {
+        if(out_index[i] == NA_INTEGER || out_index[i] < 0 || out_index[i] >= n_pos)
+            throw std::range_error("out_index out of range");
+        if(i > 0 && out_index[i] <= out_index[i-1])
+            throw std::invalid_argument("out_index should be increasing");
+    }
+}
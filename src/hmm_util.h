@@ -2,10 +2,16 @@
 #ifndef HMM_UTIL_H
 #define HMM_UTIL_H
 
+#include <Rcpp.h>
+
 // Calculate addlog(a,b) = log[exp(a) + exp(b)]
 double addlog(const double a, const double b);
 
 // Calculate  subtractlog(a,b) = log[exp(a) - exp(b)]
 double subtractlog(const double a, const double b);
 
+// check index of positions at which to output probabilities
+// (should be increasing, and within 0, ..., n_pos-1)
+void check_out_index(const Rcpp::IntegerVector& out_index, const int n_pos);
+
 #endif // HMM_UTIL_H
@@ -7,6 +7,7 @@
 #include <Rcpp.h>
 #include "cross.h"
 #include "random.h"
+#include "geno_segments.h"
 #define TOL 1e-6
 
 // find most probable sequence of genotypes
@@ -140,3 +141,21 @@ IntegerMatrix viterbi2(const String& crosstype,
     delete cross;
     return result;
 }
+
+// find most probable sequence of genotypes, returned as run-length segments
+// (see encode_geno_segments() for the output format)
+// [[Rcpp::export(".viterbi2_segments")]]
+IntegerMatrix viterbi2_segments(const String& crosstype,
+                                const IntegerMatrix& genotypes, // columns are individuals, rows are markers
+                                const IntegerMatrix& founder_geno, // columns are markers, rows are founder lines
+                                const bool is_X_chr,
+                                const bool is_female, // same for all individuals
+                                const IntegerVector& cross_info, // same for all individuals
+                                const NumericVector& rec_frac,   // length nrow(genotypes)-1
+                                const IntegerVector& marker_index, // length nrow(genotypes)
+                                const double error_prob)
+{
+    return encode_geno_segments(viterbi2(crosstype, genotypes, founder_geno, is_X_chr,
+                                         is_female, cross_info, rec_frac, marker_index,
+                                         error_prob));
+}
@@ -17,4 +17,16 @@ Rcpp::IntegerMatrix viterbi2(const Rcpp::String& crosstype,
                              const Rcpp::IntegerVector& marker_index, // length nrow(genotypes)
                              const double error_prob);
 
+// find most probable sequence of genotypes, returned as run-length segments
+// (see encode_geno_segments() for the output format)
+Rcpp::IntegerMatrix viterbi2_segments(const Rcpp::String& crosstype,
+                                      const Rcpp::IntegerMatrix& genotypes, // columns are individuals, rows are markers
+                                      const Rcpp::IntegerMatrix& founder_geno, // columns are markers, rows are founder lines
+                                      const bool is_X_chr,
+                                      const bool is_female, // same for all individuals
+                                      const Rcpp::IntegerVector& cross_info, // same for all individuals
+                                      const Rcpp::NumericVector& rec_frac,   // length nrow(genotypes)-1
+                                      const Rcpp::IntegerVector& marker_index, // length nrow(genotypes)
+                                      const double error_prob);
+
 #endif // HMM_VITERBI2_H
@@ -0,0 +1,97 @@
+// index SNPs into groups of equivalent SNPs
+//
+// With the SNPs and map both sorted by position, the intervals are
+// found by a merge, and the groups of SNPs with a common
+// (interval, on_map, sdp) are found with a hash table.
+
+#include "index_snps.h"
+#include <unordered_map>
+#include <vector>
+#include <Rcpp.h>
+
+using namespace Rcpp;
+
+// index SNPs on one chromosome
+// [[Rcpp::export(".index_snps_onechr")]]
+List index_snps_onechr(const NumericVector& pos,
+                       const IntegerVector& sdp,
+                       const NumericVector& map,
+                       const double tol)
+{
+    const int n_snp = pos.size();
+    const int n_map = map.size();
+    if(sdp.size() != n_snp)
+        throw std::invalid_argument("length(sdp) != length(pos)");
+
+    LogicalVector keep(n_snp);
+    std::vector<int> interval, on_map, index;
+    interval.reserve(n_snp);
+    on_map.reserve(n_snp);
+    index.reserve(n_snp);
+
+    // key: (interval, on_map) in the upper bits, sdp in the lower 32
+    std::unordered_map<unsigned long long, int> first_snp;
+    first_snp.reserve(n_snp < 1024 ? 1024 : n_snp/4);
+
+    int j=0; // number of map positions <= pos[i]
+    for(int i=0; i<n_snp; i++) {
+        if(ISNAN(pos[i])) { // missing positions are dropped (and sorted last)
+            keep[i] = false;
+            continue;
+        }
+        if(i > 0 && pos[i] < pos[i-1])
+            throw std::invalid_argument("pos should be sorted");
+
+        while(j < n_map && map[j] <= pos[i]) ++j;
+        const int this_interval = j-1;
+        const bool this_on_map = (this_interval >= 0 && fabs(map[this_interval] - pos[i]) <= tol);
+
+        // drop snps outside of range
+        if(this_interval < 0 || (this_interval >= n_map-1 && !this_on_map)) {
+            keep[i] = false;
+            continue;
+        }
+        keep[i] = true;
+
+        const unsigned long long key =
+            ((unsigned long long)(2*this_interval + this_on_map) << 32) |
+            (unsigned long long)(unsigned int)sdp[i];
+        const int row = interval.size() + 1;
+        const int this_index = first_snp.emplace(key, row).first->second;
+
+        interval.push_back(this_interval);
+        on_map.push_back(this_on_map);
+        index.push_back(this_index);
+    }
+
+    return List::create(Named("keep") = keep,
+                        Named("interval") = wrap(interval),
+                        Named("on_map") = LogicalVector(on_map.begin(), on_map.end()),
+                        Named("index") = wrap(index));
+}
+
+// expand LOD scores at index SNPs to all SNPs within drop of the maximum
+// [[Rcpp::export(".expand_snp_lod")]]
+IntegerVector expand_snp_lod(const IntegerVector& revindex,
+                             const NumericVector& lod,
+                             const double drop)
+{
+    const int n_snp = revindex.size();
+    const int n_lod = lod.size();
+
+    double maxlod = R_NegInf;
+    for(int i=0; i<n_lod; i++)
+        if(!ISNAN(lod[i]) && lod[i] > maxlod) maxlod = lod[i];
+    const double threshold = maxlod - drop;
+
+    std::vector<int> result;
+    for(int i=0; i<n_snp; i++) {
+        const int k = revindex[i];
+        if(k == NA_INTEGER || k < 1 || k > n_lod)
+            throw std::invalid_argument("revindex out of range");
+        if(!ISNAN(lod[k-1]) && lod[k-1] >= threshold)
+            result.push_back(i+1);
+    }
+
+    return wrap(result);
+}
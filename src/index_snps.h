@@ -0,0 +1,37 @@
+// index SNPs into groups of equivalent SNPs
+#ifndef INDEX_SNPS_H
+#define INDEX_SNPS_H
+
+#include <Rcpp.h>
+
+// index SNPs on one chromosome
+//
+// pos  = SNP positions (sorted)
+// sdp  = SNP strain distribution patterns
+// map  = marker/pseudomarker positions (sorted)
+// tol  = tolerance for a SNP to be at a map position
+//
+// output = list with
+//     keep     = logical vector; FALSE for SNPs outside the range of the map
+//     interval = map interval containing each kept SNP (starting at 0)
+//     on_map   = whether each kept SNP is at the left endpoint of its interval
+//     index    = for each kept SNP, the (1-based) index among the kept
+//                SNPs of the first SNP with the same (interval, on_map, sdp)
+Rcpp::List index_snps_onechr(const Rcpp::NumericVector& pos,
+                             const Rcpp::IntegerVector& sdp,
+                             const Rcpp::NumericVector& map,
+                             const double tol);
+
+// expand LOD scores at index SNPs to all SNPs within drop of the maximum
+//
+// revindex = for each SNP, the (1-based) row of its index SNP in lod
+// lod      = LOD scores at the index SNPs
+// drop     = LOD drop from the maximum
+//
+// output = (1-based) indexes of the SNPs whose index SNP has
+//          LOD >= max(lod) - drop
+Rcpp::IntegerVector expand_snp_lod(const Rcpp::IntegerVector& revindex,
+                                   const Rcpp::NumericVector& lod,
+                                   const double drop);
+
+#endif // INDEX_SNPS_H
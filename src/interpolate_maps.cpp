@@ -2,6 +2,7 @@
 
 #include "interpolate_maps.h"
 #include <exception>
+#include <algorithm>
 #include <Rcpp.h>
 using namespace Rcpp;
 
@@ -11,14 +12,8 @@ using namespace Rcpp;
 // map should be sorted
 int find_interval(const double pos, const NumericVector& map)
 {
-    const int n_map = map.size();
-
-    int result = -1;
-    for(int i=0; i<n_map; i++) {
-        if(map[i] > pos) return result;
-        ++result;
-    }
-    return result;
+    // number of map positions <= pos, less 1
+    return (std::upper_bound(map.begin(), map.end(), pos) - map.begin()) - 1;
 }
 
 // for positions relative to oldmap, interpolate to get positions relative to newmap
@@ -0,0 +1,55 @@
+// index of positions and intervals, for region queries
+//
+// Points are kept sorted and found by binary search. Intervals are
+// kept sorted by start, along with the cumulative maximum of the
+// stops (an implicit augmented array): the intervals that could
+// overlap [qstart, qend] are those after the first one whose
+// cumulative maximum stop reaches qstart and before the first one
+// that starts after qend, and only that range needs to be scanned.
+
+#include "interval_index.h"
+#include <algorithm>
+#include <Rcpp.h>
+
+using namespace Rcpp;
+
+// find the points within an interval
+// [[Rcpp::export(".points_in_interval")]]
+IntegerVector points_in_interval(const NumericVector& pos,
+                                 const double start, const double end)
+{
+    const NumericVector::const_iterator first = std::lower_bound(pos.begin(), pos.end(), start);
+    const NumericVector::const_iterator last = std::upper_bound(first, pos.end(), end);
+
+    IntegerVector result(2);
+    result[0] = (first - pos.begin()) + 1;
+    result[1] = (last - pos.begin());
+
+    return result;
+}
+
+// find the intervals that overlap a query interval
+// [[Rcpp::export(".intervals_overlapping")]]
+IntegerVector intervals_overlapping(const NumericVector& start,
+                                    const NumericVector& stop,
+                                    const NumericVector& stop_cummax,
+                                    const double qstart, const double qend)
+{
+    const int n = start.size();
+    if(stop.size() != n)
+        throw std::invalid_argument("length(stop) != length(start)");
+    if(stop_cummax.size() != n)
+        throw std::invalid_argument("length(stop_cummax) != length(start)");
+
+    // first interval whose cumulative max stop is >= qstart
+    const int first = std::lower_bound(stop_cummax.begin(), stop_cummax.end(), qstart) - stop_cummax.begin();
+    // first interval that starts after qend
+    const int last = std::upper_bound(start.begin(), start.end(), qend) - start.begin();
+
+    std::vector<int> result;
+    for(int i=first; i<last; i++) {
+        if(stop[i] >= qstart) result.push_back(i+1);
+    }
+
+    return wrap(result);
+}
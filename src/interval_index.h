@@ -0,0 +1,32 @@
+// index of positions and intervals, for region queries
+#ifndef INTERVAL_INDEX_H
+#define INTERVAL_INDEX_H
+
+#include <Rcpp.h>
+
+// find the points within an interval
+//
+// pos   = sorted vector of positions
+// start = start of query interval
+// end   = end of query interval
+//
+// output = vector of length 2, with the (1-based) indexes of the first
+//          and last point with start <= pos <= end (last < first if none)
+Rcpp::IntegerVector points_in_interval(const Rcpp::NumericVector& pos,
+                                       const double start, const double end);
+
+// find the intervals that overlap a query interval
+//
+// start       = interval starts, sorted
+// stop        = interval stops (in the same order as start)
+// stop_cummax = cumulative maximum of stop
+// qstart      = start of query interval
+// qend        = end of query interval
+//
+// output = (1-based) indexes of the intervals with start <= qend and stop >= qstart
+Rcpp::IntegerVector intervals_overlapping(const Rcpp::NumericVector& start,
+                                          const Rcpp::NumericVector& stop,
+                                          const Rcpp::NumericVector& stop_cummax,
+                                          const double qstart, const double qend);
+
+#endif // INTERVAL_INDEX_H
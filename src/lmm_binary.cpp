@@ -0,0 +1,257 @@
+// logistic mixed model via penalized quasi-likelihood
+//
+// Following Breslow & Clayton (1993), each iteration forms the working
+// response z = eta + (y - mu)/w, with weights w = mu(1-mu), and fits
+// the linear mixed model
+//     z = X b + g + e, var(g) = sigmasq hsq K, var(e) = sigmasq (1-hsq) W^{-1}
+// Multiplying through by W^{1/2} gives a linear mixed model with kinship
+// matrix W^{1/2} K W^{1/2} and iid residual errors, which is fit by
+// the eigen rotation in lmm.cpp. The linear predictor is then updated
+// with the BLUP of g.
+//
+// Unlike for a normal trait, the residual variance is not free: with
+// the binomial variance, var(z) = tau K + W^{-1}. We write
+// tau = hsq/(1-hsq) so that the rotated covariance matrix is
+// [hsq D + (1-hsq) I]/(1-hsq), and use getMLsoln() for the
+// estimate of beta at a given hsq, but with sigmasq fixed at 1/(1-hsq).
+
+// [[Rcpp::depends(RcppEigen)]]
+
+#include "lmm_binary.h"
+#include <math.h>
+#include <RcppEigen.h>
+#include "lmm.h"
+#include "brent_fmin.h"
+
+using namespace Rcpp;
+using namespace Eigen;
+
+// log likelihood of working model, for fixed hsq, with sigmasq = 1/(1-hsq)
+struct lmm_fit calcLL_fixedscale(const double hsq, const VectorXd& Kva, const VectorXd& y,
+                                 const MatrixXd& X, const bool reml)
+{
+    const int n = Kva.size();
+    const int p = X.cols();
+
+    struct lmm_fit ml_soln = getMLsoln(hsq, Kva, y, X, reml);
+
+    const double log_sigmasq = -log(1.0 - hsq);
+    double loglik = (double)(reml ? (n-p) : n) * log_sigmasq + ml_soln.rss * (1.0 - hsq);
+    for(int i=0; i<n; i++)
+        loglik += log(hsq*Kva[i] + 1.0 - hsq);
+    if(reml) loglik += ml_soln.logdetXSX;
+    ml_soln.loglik = -0.5*loglik;
+    ml_soln.sigmasq = 1.0/(1.0 - hsq);
+
+    return ml_soln;
+}
+
+// negative log likelihood, for the optimization
+double negLL_fixedscale(const double x, struct calcLL_args *args)
+{
+    const struct lmm_fit result = calcLL_fixedscale(x, args->Kva, args->y, args->X,
+                                                    args->reml);
+
+    return -result.loglik;
+}
+
+// optimize log likelihood of working model over hsq in [0, hsq_max]
+struct lmm_fit fitLMM_fixedscale(const VectorXd& Kva, const VectorXd& y, const MatrixXd& X,
+                                 const bool reml, const double tol)
+{
+    const double hsq_max = 0.999; // so tau <= 999
+
+    struct calcLL_args args;
+    args.Kva = Kva;
+    args.y = y;
+    args.X = X;
+    args.reml = reml;
+    args.logdetXpX = NA_REAL; // not used
+
+    const double hsq = qtl2_Brent_fmin(0.0, hsq_max, (double (*)(double, void*)) negLL_fixedscale,
+                                       &args, tol);
+    struct lmm_fit result = calcLL_fixedscale(hsq, Kva, y, X, reml);
+    result.hsq = hsq;
+
+    // check the boundaries
+    const double boundary[2] = {0.0, hsq_max};
+    for(int i=0; i<2; i++) {
+        struct lmm_fit boundary_result = calcLL_fixedscale(boundary[i], Kva, y, X, reml);
+        if(boundary_result.loglik > result.loglik) {
+            result = boundary_result;
+            result.hsq = boundary[i];
+        }
+    }
+
+    return result;
+}
+
+// PQL iterations, starting from linear predictor eta
+//
+// If Kva is non-empty, Kva and Kve_t are the eigen decomposition of the
+// weighted kinship matrix with the weights at eta; the decomposition is
+// reused whenever the weights are unchanged from those at which it was
+// computed
+List fit_lmm_binary_pql_iter(const MatrixXd& KK, const VectorXd& yy, const MatrixXd& XX,
+                             VectorXd eta, VectorXd Kva, MatrixXd Kve_t,
+                             const bool reml, const int maxit, const double bintol,
+                             const double tol, const double eta_max)
+{
+    const int n_ind = yy.size();
+    const int n_cov = XX.cols();
+
+    VectorXd sw(n_ind), z(n_ind), lambda(n_ind), sw_decomp, eta_fit;
+    MatrixXd Xstar;
+    VectorXd ystar;
+    struct lmm_fit fit;
+    bool converged = false;
+    int iter;
+
+    for(iter=0; iter<=maxit; iter++) {
+        Rcpp::checkUserInterrupt();  // check for ^C from user
+
+        // working response and weights
+        for(int i=0; i<n_ind; i++) {
+            double mu = 1.0/(1.0 + exp(-eta[i]));
+            double w = mu*(1.0 - mu);
+            sw[i] = sqrt(w);
+            z[i] = eta[i] + (yy[i] - mu)/w;
+        }
+        eta_fit = eta;
+        if(iter==0 && Kva.size() == n_ind) sw_decomp = sw;
+
+        // weighted kinship matrix and its eigen decomposition (unless weights unchanged)
+        if(sw_decomp.size() != n_ind || sw != sw_decomp) {
+            const MatrixXd Kw = sw.asDiagonal() * KK * sw.asDiagonal();
+            std::pair<VectorXd, MatrixXd> e = eigen_decomp(Kw);
+            Kva = e.first;
+            Kve_t = e.second;
+            sw_decomp = sw;
+        }
+
+        // rotation
+        ystar = Kve_t * sw.cwiseProduct(z);
+        Xstar = Kve_t * (sw.asDiagonal() * XX);
+
+        fit = fitLMM_fixedscale(Kva, ystar, Xstar, reml, tol);
+        lambda = fit.hsq * Kva.array() + (1.0 - fit.hsq);
+
+        if(iter == maxit) break; // use last fit
+
+        // BLUP of polygenic effect: hsq K W^{1/2} U Lambda^{-1} U' W^{1/2} (z - Xb)
+        const VectorXd r = (ystar - Xstar * fit.beta).cwiseQuotient(lambda);
+        const VectorXd g = fit.hsq * (KK * sw.cwiseProduct(Kve_t.transpose() * r));
+
+        // update linear predictor
+        VectorXd eta_new = XX * fit.beta + g;
+        double maxdiff = 0.0;
+        for(int i=0; i<n_ind; i++) {
+            if(eta_new[i] < -eta_max) eta_new[i] = -eta_max;
+            else if(eta_new[i] > eta_max) eta_new[i] = eta_max;
+            double d = fabs(eta_new[i] - eta[i]);
+            if(d > maxdiff) maxdiff = d;
+        }
+        eta = eta_new;
+
+        if(maxdiff < bintol) {
+            converged = true;
+            break;
+        }
+    }
+
+    // rotation to iid errors: Lambda^{-1/2} U' W^{1/2}
+    const VectorXd lambda_isqrt = lambda.cwiseSqrt().cwiseInverse();
+    MatrixXd rotation = lambda_isqrt.asDiagonal() * Kve_t * sw.asDiagonal();
+    MatrixXd RX = lambda_isqrt.asDiagonal() * Xstar;
+    VectorXd Rresid = lambda_isqrt.asDiagonal() * (ystar - Xstar * fit.beta);
+
+    // covariance matrix for beta, [X' V^{-1} X]^{-1}
+    MatrixXd XpX = RX.transpose() * RX;
+    MatrixXd beta_cov = fit.sigmasq * XpX.llt().solve(MatrixXd::Identity(n_cov, n_cov));
+
+    return List::create(Named("hsq") =       fit.hsq,
+                        Named("sigmasq") =   fit.sigmasq,
+                        Named("beta") =      fit.beta,
+                        Named("beta_cov") =  beta_cov,
+                        Named("rotation") =  rotation,
+                        Named("Rresid") =    Rresid,
+                        Named("RX") =        RX,
+                        Named("eta") =       eta_fit,
+                        Named("Kva") =       Kva,
+                        Named("Kve") =       Kve_t,
+                        Named("n_iter") =    iter,
+                        Named("converged") = converged);
+}
+
+// check dimensions of the inputs
+void check_lmm_binary_input(const NumericMatrix& K, const NumericVector& y,
+                            const NumericMatrix& X, const int maxit)
+{
+    const int n_ind = y.size();
+    if(K.rows() != n_ind || K.cols() != n_ind)
+        throw std::invalid_argument("K should be square with nrow(K) == length(y)");
+    if(X.rows() != n_ind)
+        throw std::invalid_argument("nrow(X) != length(y)");
+    if(maxit < 0)
+        throw std::invalid_argument("maxit should be >= 0");
+}
+
+// fit logistic mixed model by penalized quasi-likelihood (PQL)
+// [[Rcpp::export]]
+List fit_lmm_binary_pql(const NumericMatrix& K,
+                        const NumericVector& y,
+                        const NumericMatrix& X,
+                        const bool reml=true,
+                        const int maxit=100,
+                        const double bintol=1e-6,
+                        const double tol=1e-12,
+                        const double eta_max=30.0)
+{
+    check_lmm_binary_input(K, y, X, maxit);
+
+    const int n_ind = y.size();
+    const MatrixXd KK(as<Map<MatrixXd> >(K));
+    const VectorXd yy(as<Map<VectorXd> >(y));
+    const MatrixXd XX(as<Map<MatrixXd> >(X));
+
+    // starting values
+    VectorXd eta(n_ind);
+    for(int i=0; i<n_ind; i++) {
+        double mu = (yy[i] + 0.5)/2.0;
+        eta[i] = log(mu) - log(1.0 - mu);
+    }
+
+    return fit_lmm_binary_pql_iter(KK, yy, XX, eta, VectorXd(0), MatrixXd(0,0),
+                                   reml, maxit, bintol, tol, eta_max);
+}
+
+// fit logistic mixed model by PQL, starting from a previous fit
+// [[Rcpp::export]]
+List fit_lmm_binary_pql_start(const NumericMatrix& K,
+                              const NumericVector& y,
+                              const NumericMatrix& X,
+                              const NumericVector& eta,
+                              const NumericVector& Kva,
+                              const NumericMatrix& Kve,
+                              const bool reml=true,
+                              const int maxit=100,
+                              const double bintol=1e-6,
+                              const double tol=1e-12,
+                              const double eta_max=30.0)
+{
+    check_lmm_binary_input(K, y, X, maxit);
+
+    const int n_ind = y.size();
+    if(eta.size() != n_ind)
+        throw std::invalid_argument("length(eta) != length(y)");
+    if(Kva.size() != n_ind || Kve.rows() != n_ind || Kve.cols() != n_ind)
+        throw std::invalid_argument("Kva and Kve should be the eigen decomposition of an n x n matrix");
+
+    const MatrixXd KK(as<Map<MatrixXd> >(K));
+    const VectorXd yy(as<Map<VectorXd> >(y));
+    const MatrixXd XX(as<Map<MatrixXd> >(X));
+
+    return fit_lmm_binary_pql_iter(KK, yy, XX, as<Map<VectorXd> >(eta),
+                                   as<Map<VectorXd> >(Kva), as<Map<MatrixXd> >(Kve),
+                                   reml, maxit, bintol, tol, eta_max);
+}
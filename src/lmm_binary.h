@@ -0,0 +1,54 @@
+// logistic mixed model via penalized quasi-likelihood
+#ifndef LMM_BINARY_H
+#define LMM_BINARY_H
+
+#include <RcppEigen.h>
+
+// fit logistic mixed model by penalized quasi-likelihood (PQL)
+//
+// K       = kinship matrix (already multiplied by 2)
+// y       = binary phenotype, values in [0,1]
+// X       = matrix of covariates, including intercept
+// reml    = boolean indicating whether to use REML (vs ML)
+// maxit   = maximum number of PQL iterations
+// bintol  = tolerance for convergence (on the linear predictor)
+// tol     = tolerance for convergence of hsq
+// eta_max = maximum absolute value of the linear predictor
+//
+// output = list with hsq, sigmasq, beta, beta_cov (covariance matrix for beta),
+//          rotation (matrix R that rotates the working model to have
+//          iid errors, n x n), Rresid (rotated working residuals, R(z - Xb)),
+//          RX (rotated covariates), eta (linear predictor at which the final
+//          weights were calculated), Kva and Kve (eigenvalues and transposed
+//          eigenvectors of the weighted kinship matrix, with those weights),
+//          n_iter, and converged
+Rcpp::List fit_lmm_binary_pql(const Rcpp::NumericMatrix& K,
+                              const Rcpp::NumericVector& y,
+                              const Rcpp::NumericMatrix& X,
+                              const bool reml,
+                              const int maxit,
+                              const double bintol,
+                              const double tol,
+                              const double eta_max);
+
+// fit logistic mixed model by PQL, starting from a previous fit
+// (such as that under the null hypothesis)
+//
+// eta = linear predictor at which to start
+// Kva = eigenvalues of the weighted kinship matrix, with the weights at eta
+// Kve = corresponding transposed eigenvectors
+//
+// (the other arguments and the output are as for fit_lmm_binary_pql)
+Rcpp::List fit_lmm_binary_pql_start(const Rcpp::NumericMatrix& K,
+                                    const Rcpp::NumericVector& y,
+                                    const Rcpp::NumericMatrix& X,
+                                    const Rcpp::NumericVector& eta,
+                                    const Rcpp::NumericVector& Kva,
+                                    const Rcpp::NumericMatrix& Kve,
+                                    const bool reml,
+                                    const int maxit,
+                                    const double bintol,
+                                    const double tol,
+                                    const double eta_max);
+
+#endif // LMM_BINARY_H
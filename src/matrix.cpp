@@ -4,6 +4,7 @@
 
 #include "matrix.h"
 #include <RcppEigen.h>
+#include "simd_kernels.h"
 using namespace Rcpp;
 using namespace Eigen;
 
@@ -223,8 +224,7 @@ NumericMatrix weighted_matrix(const NumericMatrix& mat,
     NumericMatrix result(nrow,ncol);
 
     for(int j=0; j<ncol; j++)
-        for(int i=0; i<nrow; i++)
-            result(i,j) = mat(i,j)*weights[i];
+        simd_mult(mat.begin() + j*nrow, weights.begin(), result.begin() + j*nrow, nrow);
 
     return result;
 }
@@ -247,9 +247,8 @@ NumericVector weighted_3darray(const NumericVector& array,
     NumericVector result(n*ncol);
     result.attr("dim") = d;
 
-    for(int j=0, k=0; j<ncol; j++)
-        for(int i=0; i<n; i++, k++)
-            result[k] = array[k]*weights[i];
+    for(int j=0; j<ncol; j++)
+        simd_mult(array.begin() + j*n, weights.begin(), result.begin() + j*n, n);
 
     return result;
 }
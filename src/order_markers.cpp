@@ -0,0 +1,223 @@
+// marker ordering: linkage groups and seriation from pairwise recombination fractions
+
+#include "order_markers.h"
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <Rcpp.h>
+
+using namespace Rcpp;
+
+// improvements smaller than this are ignored
+static const double ORDER_TOL = 1e-12;
+
+// union-find: root of a marker's set, with path halving
+static int find_root(std::vector<int>& parent, int i)
+{
+    while(parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+// form linkage groups by union-find on linked pairs of markers
+// [[Rcpp::export(".linkage_groups")]]
+IntegerVector linkage_groups(const int n_mar,
+                             const IntegerVector& marker1,
+                             const IntegerVector& marker2)
+{
+    const int n_pairs = marker1.size();
+    if(marker2.size() != n_pairs)
+        throw std::invalid_argument("length(marker1) != length(marker2)");
+
+    std::vector<int> parent(n_mar), size(n_mar, 1);
+    for(int i=0; i<n_mar; i++) parent[i] = i;
+
+    for(int k=0; k<n_pairs; k++) {
+        const int a = marker1[k]-1, b = marker2[k]-1;
+        if(a < 0 || a >= n_mar || b < 0 || b >= n_mar)
+            throw std::range_error("marker index out of range");
+
+        int ra = find_root(parent, a), rb = find_root(parent, b);
+        if(ra == rb) continue;
+        if(size[ra] < size[rb]) std::swap(ra, rb); // union by size
+        parent[rb] = ra;
+        size[ra] += size[rb];
+    }
+
+    // groups in order of first marker, then sort by decreasing size
+    std::vector<int> root_group(n_mar, -1), groups;
+    for(int i=0; i<n_mar; i++) {
+        const int r = find_root(parent, i);
+        if(root_group[r] < 0) {
+            root_group[r] = groups.size();
+            groups.push_back(r);
+        }
+    }
+    std::vector< std::pair<int,int> > group_order(groups.size()); // (-size, group)
+    for(unsigned int g=0; g<groups.size(); g++)
+        group_order[g] = std::make_pair(-size[groups[g]], (int)g);
+    std::sort(group_order.begin(), group_order.end());
+    std::vector<int> group_label(groups.size());
+    for(unsigned int g=0; g<groups.size(); g++) group_label[group_order[g].second] = g+1;
+
+    IntegerVector result(n_mar);
+    for(int i=0; i<n_mar; i++)
+        result[i] = group_label[root_group[find_root(parent, i)]];
+
+    return result;
+}
+
+// distance between the markers at two positions in a path (0 if either is off the end)
+static inline double path_dist(const NumericMatrix& dist, const std::vector<int>& path,
+                               const int i, const int j)
+{
+    const int n = path.size();
+    if(i < 0 || j < 0 || i >= n || j >= n) return 0.0;
+    return dist(path[i], path[j]);
+}
+
+// 2-opt: reverse segments path[i..j] while that shortens the path
+static bool improve_2opt(const NumericMatrix& dist, std::vector<int>& path)
+{
+    const int n = path.size();
+    bool any = false;
+    bool improved = true;
+    while(improved) {
+        improved = false;
+        for(int i=0; i<n-1; i++) {
+            for(int j=i+1; j<n; j++) {
+                const double delta = path_dist(dist, path, i-1, j) + path_dist(dist, path, i, j+1) -
+                    path_dist(dist, path, i-1, i) - path_dist(dist, path, j, j+1);
+                if(delta < -ORDER_TOL) {
+                    std::reverse(path.begin()+i, path.begin()+j+1);
+                    improved = any = true;
+                }
+            }
+        }
+    }
+    return any;
+}
+
+// single-marker moves: remove the marker at position i and re-insert it elsewhere
+static bool improve_move(const NumericMatrix& dist, std::vector<int>& path)
+{
+    const int n = path.size();
+    bool any = false;
+    bool improved = true;
+    while(improved) {
+        improved = false;
+        for(int i=0; i<n; i++) {
+            const int m = path[i];
+            // gain from removing marker i
+            const double removal = path_dist(dist, path, i-1, i) + path_dist(dist, path, i, i+1) -
+                path_dist(dist, path, i-1, i+1);
+
+            // best insertion point, in the path without marker i: between k-1 and k
+            std::vector<int> rest(path);
+            rest.erase(rest.begin()+i);
+            int best_k = -1;
+            double best_cost = removal - ORDER_TOL;
+            for(int k=0; k<=n-1; k++) {
+                if(k == i) continue; // original position
+                double cost;
+                if(k == 0) cost = dist(m, rest[0]);
+                else if(k == n-1) cost = dist(rest[n-2], m);
+                else cost = dist(rest[k-1], m) + dist(m, rest[k]) - dist(rest[k-1], rest[k]);
+                if(cost < best_cost) {
+                    best_cost = cost;
+                    best_k = k;
+                }
+            }
+            if(best_k >= 0) {
+                rest.insert(rest.begin()+best_k, m);
+                path.swap(rest);
+                improved = any = true;
+            }
+        }
+    }
+    return any;
+}
+
+static double path_total(const NumericMatrix& dist, const std::vector<int>& path)
+{
+    double result = 0.0;
+    for(unsigned int i=1; i<path.size(); i++) result += dist(path[i-1], path[i]);
+    return result;
+}
+
+// order markers to minimize the sum of adjacent distances
+// [[Rcpp::export(".order_tsp")]]
+IntegerVector order_tsp(const NumericMatrix& dist, const int n_start)
+{
+    const int n = dist.rows();
+    if(dist.cols() != n)
+        throw std::invalid_argument("dist should be a square matrix");
+    if(n_start < 1)
+        throw std::invalid_argument("n_start should be >= 1");
+    for(int i=0; i<dist.size(); i++) {
+        if(ISNAN(dist[i]))
+            throw std::invalid_argument("dist should not contain missing values");
+    }
+
+    std::vector<int> best_path(n);
+    for(int i=0; i<n; i++) best_path[i] = i;
+    double best_length = path_total(dist, best_path);
+
+    if(n > 2) {
+        const int n_s = std::min(n_start, n);
+        for(int s=0; s<n_s; s++) {
+            Rcpp::checkUserInterrupt();  // check for ^C from user
+
+            // nearest-neighbor path from an evenly-spaced starting marker
+            const int start = (int)((double)s * n / n_s);
+            std::vector<bool> used(n, false);
+            std::vector<int> path;
+            path.push_back(start);
+            used[start] = true;
+            for(int k=1; k<n; k++) {
+                const int last = path.back();
+                int next = -1;
+                for(int j=0; j<n; j++) {
+                    if(used[j]) continue;
+                    if(next < 0 || dist(last, j) < dist(last, next)) next = j;
+                }
+                path.push_back(next);
+                used[next] = true;
+            }
+
+            // local refinement, until neither move helps
+            improve_2opt(dist, path);
+            while(improve_move(dist, path) && improve_2opt(dist, path)) {}
+
+            const double length = path_total(dist, path);
+            if(length < best_length - ORDER_TOL) {
+                best_length = length;
+                best_path.swap(path);
+            }
+        }
+    }
+
+    // orient so that the first marker has the smaller index
+    if(n > 1 && best_path[0] > best_path[n-1])
+        std::reverse(best_path.begin(), best_path.end());
+
+    IntegerVector result(n);
+    for(int i=0; i<n; i++) result[i] = best_path[i]+1;
+    return result;
+}
+
+// sum of adjacent distances for an order
+// [[Rcpp::export(".path_length")]]
+double path_length(const NumericMatrix& dist, const IntegerVector& order)
+{
+    const int n = order.size();
+    std::vector<int> path(n);
+    for(int i=0; i<n; i++) {
+        if(order[i] < 1 || order[i] > dist.rows())
+            throw std::range_error("order out of range");
+        path[i] = order[i]-1;
+    }
+    return path_total(dist, path);
+}
@@ -0,0 +1,34 @@
+// marker ordering: linkage groups and seriation from pairwise recombination fractions
+#ifndef ORDER_MARKERS_H
+#define ORDER_MARKERS_H
+
+#include <Rcpp.h>
+
+// form linkage groups by union-find on linked pairs of markers
+//
+// n_mar   = number of markers
+// marker1 = first marker in each linked pair (indexes from 1)
+// marker2 = second marker in each linked pair (indexes from 1)
+//
+// output  = linkage group for each marker, numbered from 1 by decreasing size
+//           (ties by the first marker in the group)
+Rcpp::IntegerVector linkage_groups(const int n_mar,
+                                   const Rcpp::IntegerVector& marker1,
+                                   const Rcpp::IntegerVector& marker2);
+
+// order markers to minimize the sum of adjacent distances (open-path TSP),
+// by nearest-neighbor paths refined with 2-opt and single-marker moves
+//
+// dist    = symmetric matrix of distances between markers (e.g., recombination fractions)
+// n_start = number of starting markers for the nearest-neighbor paths
+//
+// output  = marker order (indexes from 1)
+Rcpp::IntegerVector order_tsp(const Rcpp::NumericMatrix& dist, const int n_start);
+
+// sum of adjacent distances for an order
+//
+// dist    = symmetric matrix of distances between markers
+// order   = marker order (indexes from 1)
+double path_length(const Rcpp::NumericMatrix& dist, const Rcpp::IntegerVector& order);
+
+#endif // ORDER_MARKERS_H
@@ -0,0 +1,215 @@
+// parse VCF records of founder genotypes into variant records
+
+#include "parse_vcf.h"
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <stdlib.h>
+#include <Rcpp.h>
+#include "snpprobs.h"
+using namespace Rcpp;
+
+// split a string at a delimiter
+static void split_string(const std::string& s, const char delim, std::vector<std::string>& result)
+{
+    result.clear();
+    std::string::size_type start = 0;
+    while(true) {
+        const std::string::size_type end = s.find(delim, start);
+        if(end == std::string::npos) {
+            result.push_back(s.substr(start));
+            return;
+        }
+        result.push_back(s.substr(start, end-start));
+        start = end+1;
+    }
+}
+
+// for sorting alleles by decreasing count
+struct by_count {
+    const std::vector<int>& count;
+    by_count(const std::vector<int>& c) : count(c) {}
+    bool operator()(const int a, const int b) const {
+        return count[a] > count[b];
+    }
+};
+
+// allele from a homozygous genotype call ("1/1", "1|1", or haploid "1"); -1 if missing or heterozygous
+static int homozygous_allele(const std::string& gt)
+{
+    if(gt.empty() || gt[0] == '.') return -1;
+
+    std::string::size_type sep = gt.find_first_of("/|");
+    const std::string a1 = gt.substr(0, sep);
+    if(sep != std::string::npos && gt.substr(sep+1) != a1) return -1;
+
+    char* end;
+    const long allele = strtol(a1.c_str(), &end, 10);
+    if(*end != '\0' || allele < 0) return -1;
+    return (int)allele;
+}
+
+// parse VCF data lines into variant records
+// [[Rcpp::export(".parse_vcf_lines")]]
+List parse_vcf_lines(const CharacterVector& lines,
+                     const IntegerVector& sample_index,
+                     const int ref_pos,
+                     const bool require_fi)
+{
+    const int n_lines = lines.size();
+    const int n_sel = sample_index.size();
+    const int n_str = n_sel + (ref_pos >= 0 ? 1 : 0);
+    if(ref_pos > n_sel)
+        throw std::invalid_argument("ref_pos out of range");
+    if(n_str < 2)
+        throw std::invalid_argument("Need genotypes on >= 2 strains");
+    if(n_str > 30)
+        throw std::invalid_argument("Can have at most 30 strains");
+
+    std::vector<std::string> snp_id, chr, alleles, ensembl_gene, consequence, type;
+    std::vector<int> pos, geno; // geno: strains within records
+    std::vector<bool> with_csq;
+    std::vector<std::string> fields, format, sample_fields, alt, csq;
+    std::vector<int> allele(n_str), count, order, number;
+
+    for(int line=0; line<n_lines; line++) {
+        if(line % 10000 == 0) Rcpp::checkUserInterrupt();  // check for ^C from user
+
+        const std::string s = Rcpp::as<std::string>(lines[line]);
+        if(s.empty() || s[0] == '#') continue;
+
+        split_string(s, '\t', fields);
+        if(fields.size() < 10)
+            throw std::invalid_argument("VCF line has fewer than 10 fields");
+
+        // GT and FI in FORMAT
+        split_string(fields[8], ':', format);
+        int gt_field = -1, fi_field = -1;
+        for(unsigned int i=0; i<format.size(); i++) {
+            if(format[i] == "GT") gt_field = i;
+            else if(format[i] == "FI") fi_field = i;
+        }
+        if(gt_field < 0) continue;
+
+        // strain alleles
+        bool keep = true;
+        for(int i=0, str=0; i<n_sel && keep; i++, str++) {
+            if(str == ref_pos) allele[str++] = 0;
+
+            const unsigned int col = 9 + sample_index[i];
+            if(col >= fields.size())
+                throw std::invalid_argument("VCF line has too few samples");
+            split_string(fields[col], ':', sample_fields);
+
+            if(require_fi && fi_field >= 0 &&
+               ((int)sample_fields.size() <= fi_field || sample_fields[fi_field] != "1"))
+                keep = false;
+            else if((int)sample_fields.size() <= gt_field)
+                keep = false;
+            else {
+                allele[str] = homozygous_allele(sample_fields[gt_field]);
+                if(allele[str] < 0) keep = false;
+            }
+        }
+        if(!keep) continue;
+        if(ref_pos == n_sel) allele[n_sel] = 0;
+
+        split_string(fields[4], ',', alt);
+        const int n_alleles = alt.size() + 1;
+        std::vector<std::string> allele_seq(n_alleles);
+        allele_seq[0] = fields[3];
+        for(int a=1; a<n_alleles; a++) allele_seq[a] = alt[a-1];
+
+        // count strains with each allele
+        count.assign(n_alleles, 0);
+        for(int str=0; str<n_str && keep; str++) {
+            if(allele[str] >= n_alleles) keep = false;
+            else count[allele[str]]++;
+        }
+        if(!keep) continue;
+
+        int n_seen = 0;
+        for(int a=0; a<n_alleles; a++) if(count[a] > 0) n_seen++;
+        if(n_seen < 2) continue; // monomorphic
+
+        // order alleles by decreasing count; the sort is stable, so ties
+        // stay in VCF order and the reference allele wins ties for first
+        order.resize(n_alleles);
+        for(int a=0; a<n_alleles; a++) order[a] = a;
+        std::stable_sort(order.begin(), order.end(), by_count(count));
+
+        // number the observed alleles consecutively, from 1
+        number.assign(n_alleles, 0);
+        std::string major, minor;
+        bool is_snp = true;
+        for(int i=0, k=0; i<n_alleles; i++) {
+            const int a = order[i];
+            if(allele_seq[a].size() != 1) is_snp = false;
+            if(count[a] == 0) continue;
+            number[a] = ++k;
+            if(k == 1) major = allele_seq[a];
+            else {
+                if(!minor.empty()) minor += "/";
+                minor += allele_seq[a];
+            }
+        }
+
+        // consequence, from the first CSQ entry in INFO
+        std::string gene, csq_type;
+        bool has_csq = false;
+        const std::string::size_type csq_start = fields[7].find("CSQ=");
+        if(csq_start != std::string::npos && (csq_start == 0 || fields[7][csq_start-1] == ';')) {
+            std::string value = fields[7].substr(csq_start+4);
+            value = value.substr(0, value.find_first_of(";,"));
+            split_string(value, '|', csq);
+            if(csq.size() > 4) {
+                has_csq = true;
+                gene = csq[1];
+                csq_type = csq[4];
+                for(std::string::size_type i=0; i<csq_type.size(); i++)
+                    if(csq_type[i] == '&') csq_type[i] = ',';
+            }
+        }
+
+        if(fields[2] == ".") snp_id.push_back(fields[0] + ":" + fields[1] + "_" + fields[3] + "/" + fields[4]);
+        else snp_id.push_back(fields[2]);
+        chr.push_back(fields[0]);
+        pos.push_back(atoi(fields[1].c_str()));
+        alleles.push_back(major + "|" + minor);
+        with_csq.push_back(has_csq);
+        ensembl_gene.push_back(gene);
+        consequence.push_back(csq_type);
+        type.push_back(is_snp ? "snp" : "indel");
+        for(int str=0; str<n_str; str++) geno.push_back(number[allele[str]]);
+    }
+
+    // SDPs from major vs other alleles, as 0/1
+    const int n_rec = pos.size();
+    IntegerMatrix genomat(n_rec, n_str), binary(n_rec, n_str);
+    for(int rec=0; rec<n_rec; rec++) {
+        for(int str=0; str<n_str; str++) {
+            genomat(rec,str) = geno[rec*n_str + str];
+            binary(rec,str) = (genomat(rec,str) > 1 ? 1 : 0);
+        }
+    }
+    IntegerVector sdp = calc_sdp(binary);
+
+    CharacterVector ensembl_gene_R(n_rec), consequence_R(n_rec);
+    for(int rec=0; rec<n_rec; rec++) {
+        if(with_csq[rec]) {
+            ensembl_gene_R[rec] = ensembl_gene[rec];
+            consequence_R[rec] = consequence[rec];
+        }
+        else ensembl_gene_R[rec] = consequence_R[rec] = NA_STRING;
+    }
+
+    return List::create(Named("snp_id") = wrap(snp_id),
+                        Named("chr") = wrap(chr),
+                        Named("pos") = wrap(pos),
+                        Named("alleles") = wrap(alleles),
+                        Named("sdp") = sdp,
+                        Named("ensembl_gene") = ensembl_gene_R,
+                        Named("consequence") = consequence_R,
+                        Named("geno") = genomat,
+                        Named("type") = wrap(type));
+}
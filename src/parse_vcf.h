@@ -0,0 +1,28 @@
+// parse VCF records of founder genotypes into variant records
+#ifndef PARSE_VCF_H
+#define PARSE_VCF_H
+
+#include <Rcpp.h>
+
+// parse VCF data lines into variant records
+//
+// lines        = VCF data lines (no header lines)
+// sample_index = columns (from 0, among the samples) of the strains to keep
+// ref_pos      = position (from 0) at which to insert a strain with the
+//                reference allele, or -1 for none
+// require_fi   = if true and FORMAT includes FI, keep only records with FI==1
+//                for all of the selected strains
+//
+// output       = list with snp_id, chr, pos, alleles, sdp, ensembl_gene,
+//                consequence, geno (records x strains, with alleles numbered
+//                from 1 in decreasing frequency, ties in VCF order, so that
+//                the reference allele is 1 if it is among the most common),
+//                and type ("snp" or "indel"),
+//                for the records where all strains are homozygous
+//                and that are polymorphic
+Rcpp::List parse_vcf_lines(const Rcpp::CharacterVector& lines,
+                           const Rcpp::IntegerVector& sample_index,
+                           const int ref_pos,
+                           const bool require_fi);
+
+#endif // PARSE_VCF_H
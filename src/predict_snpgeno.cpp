@@ -1,40 +1,134 @@
 // get predicted SNP genotypes from inferred genotypes + founder genotypes
+//
+// The founder genotypes at each marker are packed into a pair of bit
+// masks (founders with the 3 allele, and founders with non-missing
+// genotypes), so that the inner loop, over individuals within a
+// marker, is a couple of shifts on contiguous data.
 
 #include "predict_snpgeno.h"
+#include <stdint.h>
+#include <vector>
 #include <Rcpp.h>
 using namespace Rcpp;
 
-// [[Rcpp::export(".predict_snpgeno")]]
-IntegerMatrix predict_snpgeno(const IntegerMatrix& allele1,
-                              const IntegerMatrix& allele2,
-                              const IntegerMatrix& founder_geno)
+// pack founder genotypes into bit masks, for each marker
+void pack_founder_geno(const IntegerMatrix& founder_geno,
+                       std::vector<uint64_t>& allele3,
+                       std::vector<uint64_t>& observed)
 {
-    const int n_ind = allele1.rows();
-    const int n_mar = allele1.cols();
     const int n_founders = founder_geno.rows();
-    if(n_ind != allele2.rows())
-        throw std::invalid_argument("nrow(allele1) != nrow(allele2)");
-    if(n_mar != allele2.cols())
-        throw std::invalid_argument("ncol(allele1) != ncol(allele2)");
+    const int n_mar = founder_geno.cols();
+    if(n_founders > 64)
+        throw std::invalid_argument("Can't handle more than 64 founders");
+
+    allele3.assign(n_mar, 0);
+    observed.assign(n_mar, 0);
+    for(int mar=0; mar<n_mar; mar++) {
+        for(int f=0; f<n_founders; f++) {
+            const int g = founder_geno(f,mar);
+            if(g == 0 || g == NA_INTEGER) continue;
+            observed[mar] |= ((uint64_t)1 << f);
+            if(g == 3) allele3[mar] |= ((uint64_t)1 << f);
+        }
+    }
+}
+
+// predicted SNP genotypes from phased genotypes
+// [[Rcpp::export(".predict_snpgeno")]]
+IntegerMatrix predict_snpgeno(const IntegerVector& phase,
+                              const IntegerMatrix& founder_geno,
+                              const LogicalVector& hemizygous)
+{
+    if(Rf_isNull(phase.attr("dim")))
+        throw std::invalid_argument("phase should be a 3d array but has no dim attribute");
+    const Dimension d = phase.attr("dim");
+    if(d.size() != 3)
+        throw std::invalid_argument("phase should be a 3d array");
+    const int n_ind = d[0];
+    const int n_mar = d[1];
+    if(d[2] != 2)
+        throw std::invalid_argument("dim(phase)[3] should be 2");
     if(n_mar != founder_geno.cols())
-        throw std::invalid_argument("ncol(allele1) != ncol(founder_geno)");
+        throw std::invalid_argument("ncol(phase) != ncol(founder_geno)");
+    if(hemizygous.size() != n_ind)
+        throw std::invalid_argument("length(hemizygous) != nrow(phase)");
+    const int n_founders = founder_geno.rows();
+
+    std::vector<uint64_t> allele3, observed;
+    pack_founder_geno(founder_geno, allele3, observed);
+
+    // offset to the second allele, by individual
+    std::vector<int> offset2(n_ind);
+    for(int ind=0; ind<n_ind; ind++)
+        offset2[ind] = hemizygous[ind] ? 0 : n_ind*n_mar;
 
     IntegerMatrix result(n_ind, n_mar);
-    for(int ind=0; ind<n_ind; ind++) {
-        for(int mar=0; mar<n_mar; mar++) {
-            if(!IntegerVector::is_na(allele1(ind,mar)) &&
-               !IntegerVector::is_na(allele2(ind,mar)) &&
-               founder_geno(allele1(ind,mar)-1,mar)!=0 &&
-               founder_geno(allele2(ind,mar)-1,mar)!=0 &&
-               allele1(ind,mar) <= n_founders &&
-               allele2(ind,mar) <= n_founders) {
-
-                result(ind,mar) = (founder_geno(allele1(ind,mar)-1,mar) - 1)/2 +
-                    (founder_geno(allele2(ind,mar)-1,mar)-1)/2 + 1;
-
-            } else {
+    for(int mar=0; mar<n_mar; mar++) {
+        const uint64_t a3 = allele3[mar];
+        const uint64_t obs = observed[mar];
+        const int* ph = &(phase[mar*n_ind]);
+
+        for(int ind=0; ind<n_ind; ind++) {
+            const int a1 = ph[ind] - 1;
+            const int a2 = ph[ind + offset2[ind]] - 1;
+
+            // NA_INTEGER is negative, so also caught here
+            if(a1 < 0 || a1 >= n_founders || a2 < 0 || a2 >= n_founders ||
+               !((obs >> a1) & 1) || !((obs >> a2) & 1)) {
                 result(ind,mar) = NA_INTEGER;
             }
+            else {
+                result(ind,mar) = 1 + (int)((a3 >> a1) & 1) + (int)((a3 >> a2) & 1);
+            }
+        }
+    }
+
+    return result;
+}
+
+// expected SNP dosages from allele probabilities
+// [[Rcpp::export(".predict_snpdosage")]]
+NumericMatrix predict_snpdosage(const NumericVector& alleleprob,
+                                const IntegerMatrix& founder_geno)
+{
+    if(Rf_isNull(alleleprob.attr("dim")))
+        throw std::invalid_argument("alleleprob should be a 3d array but has no dim attribute");
+    const Dimension d = alleleprob.attr("dim");
+    if(d.size() != 3)
+        throw std::invalid_argument("alleleprob should be a 3d array");
+    const int n_ind = d[0];
+    const int n_founders = d[1];
+    const int n_mar = d[2];
+    if(n_mar != founder_geno.cols())
+        throw std::invalid_argument("dim(alleleprob)[3] != ncol(founder_geno)");
+    if(n_founders != founder_geno.rows())
+        throw std::invalid_argument("ncol(alleleprob) != nrow(founder_geno)");
+
+    std::vector<uint64_t> allele3, observed;
+    pack_founder_geno(founder_geno, allele3, observed);
+
+    NumericMatrix result(n_ind, n_mar);
+    std::vector<double> p3(n_ind), pobs(n_ind);
+    for(int mar=0; mar<n_mar; mar++) {
+        Rcpp::checkUserInterrupt();  // check for ^C from user
+
+        std::fill(p3.begin(), p3.end(), 0.0);
+        std::fill(pobs.begin(), pobs.end(), 0.0);
+
+        // one founder at a time, over contiguous individuals
+        for(int f=0; f<n_founders; f++) {
+            if(!((observed[mar] >> f) & 1)) continue;
+            const bool is3 = (allele3[mar] >> f) & 1;
+            const double* pr = &(alleleprob[(mar*n_founders + f)*n_ind]);
+            for(int ind=0; ind<n_ind; ind++) {
+                pobs[ind] += pr[ind];
+                if(is3) p3[ind] += pr[ind];
+            }
+        }
+
+        for(int ind=0; ind<n_ind; ind++) {
+            if(pobs[ind] > 0.0) result(ind,mar) = 2.0*p3[ind]/pobs[ind];
+            else result(ind,mar) = NA_REAL;
         }
     }
 
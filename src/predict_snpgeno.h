@@ -5,9 +5,28 @@
 
 #include <Rcpp.h>
 
-Rcpp::IntegerMatrix predict_snpgeno(const Rcpp::IntegerMatrix& allele1,
-                                    const Rcpp::IntegerMatrix& allele2,
-                                    const Rcpp::IntegerMatrix& founder_geno);
+// predicted SNP genotypes from phased genotypes
+//
+// phase        = individuals x markers x 2 array of founder alleles (1, ..., n_founders)
+// founder_geno = founders x markers matrix of founder SNP genotypes (1/3, 0 = missing)
+// hemizygous   = logical vector indicating individuals with just one allele
+//                (males on the X chromosome); for these, the first allele is used twice
+//
+// output = individuals x markers matrix of SNP genotypes, 1/2/3 (NA = missing)
+Rcpp::IntegerMatrix predict_snpgeno(const Rcpp::IntegerVector& phase,
+                                    const Rcpp::IntegerMatrix& founder_geno,
+                                    const Rcpp::LogicalVector& hemizygous);
+
+// expected SNP dosages from allele probabilities
+//
+// alleleprob   = individuals x founders x markers array of allele probabilities
+// founder_geno = founders x markers matrix of founder SNP genotypes (1/3, 0 = missing)
+//
+// output = individuals x markers matrix of expected number of 3 alleles (0-2),
+//          with the allele probabilities rescaled to the founders with
+//          non-missing genotypes (NA if there are none)
+Rcpp::NumericMatrix predict_snpdosage(const Rcpp::NumericVector& alleleprob,
+                                      const Rcpp::IntegerMatrix& founder_geno);
 
 
 #endif // QTL2_PREDICT_SNPGENO
@@ -0,0 +1,98 @@
+// joint genome scan of multiple phenotypes by Haley-Knott regression
+//
+// The phenotypes are first whitened using the Cholesky decomposition
+// of their residual cross-product matrix under the null, L L' = Y'Y,
+// so that W = Y L^{-T} has W'W = I. If Q is an orthonormal basis for
+// the genotype probabilities at a position (of rank r, typically 1 less
+// than the number of genotypes), then
+//     det(RSS) / det(RSS0) = det(I_r - (Q'W)(Q'W)'),
+// which is just an r x r determinant, calculated with a small Cholesky
+// decomposition.
+
+// [[Rcpp::depends(RcppEigen)]]
+
+#include "scan1_multi.h"
+#include <math.h>
+#include <RcppEigen.h>
+
+using namespace Rcpp;
+using namespace Eigen;
+
+// Joint scan of a single chromosome, with no additive covariates (not even intercept)
+//
+// genoprobs = 3d array of genotype probabilities (individuals x genotypes x positions)
+// pheno     = matrix of numeric phenotypes (individuals x phenotypes)
+//             (no missing data allowed)
+// tol       = tolerance value for QR decomposition for linear regression
+//
+// output    = vector of log10 det(RSS0) - log10 det(RSS) (one value per position),
+//             with RSS0 = t(pheno) %*% pheno and RSS the matrix of residual
+//             sums of squares and cross-products with the QTL
+//
+// [[Rcpp::export]]
+NumericVector scan_hk_onechr_multi(const NumericVector& genoprobs,
+                                   const NumericMatrix& pheno,
+                                   const double tol=1e-12)
+{
+    const int n_ind = pheno.rows();
+    const int n_phe = pheno.cols();
+    if(Rf_isNull(genoprobs.attr("dim")))
+        throw std::invalid_argument("genoprobs should be a 3d array but has no dim attribute");
+    const Dimension d = genoprobs.attr("dim");
+    if(d.size() != 3)
+        throw std::invalid_argument("genoprobs should be a 3d array");
+    const int n_pos = d[2];
+    const int n_gen = d[1];
+    const int x_size = n_ind * n_gen;
+    if(d[0] != n_ind)
+        throw std::range_error("nrow(pheno) != nrow(genoprobs)");
+    if(n_phe >= n_ind)
+        throw std::invalid_argument("need more individuals than phenotypes");
+
+    const MatrixXd Y(as<Map<MatrixXd> >(pheno));
+
+    // whiten the phenotypes
+    LLT<MatrixXd> chol0(Y.transpose() * Y);
+    if(chol0.info() != Success)
+        throw std::invalid_argument("residual cross-product matrix of phenotypes is not positive definite");
+    const MatrixXd W = chol0.matrixL().solve(Y.transpose()).transpose();
+
+    typedef Eigen::ColPivHouseholderQR<MatrixXd> CPivQR;
+    const double log10e = 1.0/log(10.0);
+
+    NumericVector result(n_pos);
+
+    for(int pos=0, offset=0; pos<n_pos; pos++, offset += x_size) {
+        Rcpp::checkUserInterrupt();  // check for ^C from user
+
+        const Map<const MatrixXd> X(genoprobs.begin() + offset, n_ind, n_gen);
+
+        CPivQR PQR ( X );
+        PQR.setThreshold(tol); // set tolerance
+        const int r = PQR.rank();
+        if(r == 0) {
+            result[pos] = 0.0;
+            continue;
+        }
+
+        // C = Q'W, with Q the first r columns of the Householder Q
+        MatrixXd C = W;
+        C.applyOnTheLeft(PQR.householderQ().adjoint());
+        C.conservativeResize(r, n_phe);
+
+        // r x r Cholesky for log det(I - CC')
+        MatrixXd M = MatrixXd::Identity(r, r);
+        M.noalias() -= C * C.transpose();
+        LLT<MatrixXd> chol(M);
+        if(chol.info() != Success) { // QTL explains (nearly) everything
+            result[pos] = R_PosInf;
+            continue;
+        }
+
+        double logdet = 0.0;
+        for(int i=0; i<r; i++) logdet += log(chol.matrixLLT()(i,i));
+        result[pos] = -2.0 * logdet * log10e;
+    }
+
+    return result;
+}
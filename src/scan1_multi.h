@@ -0,0 +1,21 @@
+// joint genome scan of multiple phenotypes by Haley-Knott regression
+#ifndef SCAN1_MULTI_H
+#define SCAN1_MULTI_H
+
+#include <RcppEigen.h>
+
+// Joint scan of a single chromosome, with no additive covariates (not even intercept)
+//
+// genoprobs = 3d array of genotype probabilities (individuals x genotypes x positions)
+// pheno     = matrix of numeric phenotypes (individuals x phenotypes)
+//             (no missing data allowed)
+// tol       = tolerance value for QR decomposition for linear regression
+//
+// output    = vector of log10 det(RSS0) - log10 det(RSS) (one value per position),
+//             with RSS0 = t(pheno) %*% pheno and RSS the matrix of residual
+//             sums of squares and cross-products with the QTL
+Rcpp::NumericVector scan_hk_onechr_multi(const Rcpp::NumericVector& genoprobs,
+                                         const Rcpp::NumericMatrix& pheno,
+                                         const double tol);
+
+#endif // SCAN1_MULTI_H
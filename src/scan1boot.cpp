@@ -0,0 +1,122 @@
+// bootstrap of QTL location by Haley-Knott regression
+//
+// With weights w, the weighted regression of y on Z = [addcovar, genoprobs]
+// needs only Z'WZ, Z'Wy, and y'Wy, and each of these is linear in w.
+// So at each position, we form the products of the columns of Z and y
+// for each individual, and a single matrix multiplication against the
+// matrix of weights gives the normal equations for every replicate.
+
+// [[Rcpp::depends(RcppEigen)]]
+
+#include "scan1boot.h"
+#include <RcppEigen.h>
+
+using namespace Rcpp;
+using namespace Eigen;
+
+// Location of the maximum LOD score on a single chromosome, for each of
+// a batch of weight vectors (e.g., bootstrap resamples as case weights)
+//
+// genoprobs    = 3d array of genotype probabilities (individuals x genotypes x positions)
+// pheno        = matrix of numeric phenotypes (individuals x phenotypes)
+//                (no missing data allowed)
+// addcovar     = additive covariates (an intercept, at least)
+// boot_weights = matrix of weights (individuals x replicates); not the square-root
+// tol          = tolerance for dropping small eigenvalues in solving the
+//                normal equations
+//
+// output       = integer matrix (replicates x phenotypes) with the index
+//                (starting at 1) of the position with the maximum LOD score
+//
+// [[Rcpp::export]]
+IntegerMatrix boot_peaks_hk_onechr(const NumericVector& genoprobs,
+                                   const NumericMatrix& pheno,
+                                   const NumericMatrix& addcovar,
+                                   const NumericMatrix& boot_weights,
+                                   const double tol=1e-10)
+{
+    const int n_ind = pheno.rows();
+    const int n_phe = pheno.cols();
+    if(Rf_isNull(genoprobs.attr("dim")))
+        throw std::invalid_argument("genoprobs should be a 3d array but has no dim attribute");
+    const Dimension d = genoprobs.attr("dim");
+    if(d.size() != 3)
+        throw std::invalid_argument("genoprobs should be a 3d array");
+    if(n_ind != d[0])
+        throw std::range_error("nrow(pheno) != nrow(genoprobs)");
+    if(n_ind != addcovar.rows())
+        throw std::range_error("nrow(pheno) != nrow(addcovar)");
+    if(n_ind != boot_weights.rows())
+        throw std::range_error("nrow(pheno) != nrow(boot_weights)");
+    const int n_gen = d[1];
+    const int n_pos = d[2];
+    const int n_cov = addcovar.cols();
+    const int n_rep = boot_weights.cols();
+    const int k = n_cov + n_gen;
+
+    // columns of the products matrix:
+    //   upper triangle of Z'Z, then Z'y for each phenotype, then y'y for each phenotype
+    const int n_zz = k*(k+1)/2;
+    const int n_prod = n_zz + k*n_phe + n_phe;
+
+    const Map<const MatrixXd> W(boot_weights.begin(), n_ind, n_rep);
+    const Map<const MatrixXd> Y(pheno.begin(), n_ind, n_phe);
+
+    MatrixXd Z(n_ind, k);
+    Z.leftCols(n_cov) = as<Map<MatrixXd> >(addcovar);
+    MatrixXd prod(n_ind, n_prod);
+    MatrixXd S(n_prod, n_rep);
+    MatrixXd A(k, k), V(k, n_phe);
+
+    MatrixXd min_rss = MatrixXd::Constant(n_rep, n_phe, R_PosInf);
+    IntegerMatrix result(n_rep, n_phe);
+
+    for(int pos=0; pos<n_pos; pos++) {
+        Rcpp::checkUserInterrupt();  // check for ^C from user
+
+        Z.rightCols(n_gen) = Map<const MatrixXd>(genoprobs.begin() + pos*n_ind*n_gen, n_ind, n_gen);
+
+        // products for each individual
+        int col=0;
+        for(int i=0; i<k; i++)
+            for(int j=i; j<k; j++, col++)
+                prod.col(col) = Z.col(i).cwiseProduct(Z.col(j));
+        for(int phe=0; phe<n_phe; phe++)
+            for(int i=0; i<k; i++, col++)
+                prod.col(col) = Z.col(i).cwiseProduct(Y.col(phe));
+        for(int phe=0; phe<n_phe; phe++, col++)
+            prod.col(col) = Y.col(phe).cwiseAbs2();
+
+        // normal equations for all replicates at once
+        S.noalias() = prod.transpose() * W;
+
+        for(int rep=0; rep<n_rep; rep++) {
+            col = 0;
+            for(int i=0; i<k; i++)
+                for(int j=i; j<k; j++, col++)
+                    A(i,j) = A(j,i) = S(col, rep);
+            for(int phe=0; phe<n_phe; phe++)
+                for(int i=0; i<k; i++, col++)
+                    V(i,phe) = S(col, rep);
+
+            // RSS = y'Wy - v' A^+ v, with pseudo-inverse via eigen decomposition
+            SelfAdjointEigenSolver<MatrixXd> es(A);
+            const VectorXd& eval = es.eigenvalues();
+            const double thresh = tol * eval[k-1];
+            const MatrixXd UV = es.eigenvectors().transpose() * V;
+
+            for(int phe=0; phe<n_phe; phe++) {
+                double rss = S(n_zz + k*n_phe + phe, rep);
+                for(int i=0; i<k; i++)
+                    if(eval[i] > thresh) rss -= UV(i,phe)*UV(i,phe)/eval[i];
+
+                if(rss < min_rss(rep,phe)) {
+                    min_rss(rep,phe) = rss;
+                    result(rep,phe) = pos+1;
+                }
+            }
+        }
+    }
+
+    return result;
+}
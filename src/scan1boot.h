@@ -0,0 +1,26 @@
+// bootstrap of QTL location by Haley-Knott regression
+#ifndef SCAN1BOOT_H
+#define SCAN1BOOT_H
+
+#include <RcppEigen.h>
+
+// Location of the maximum LOD score on a single chromosome, for each of
+// a batch of weight vectors (e.g., bootstrap resamples as case weights)
+//
+// genoprobs    = 3d array of genotype probabilities (individuals x genotypes x positions)
+// pheno        = matrix of numeric phenotypes (individuals x phenotypes)
+//                (no missing data allowed)
+// addcovar     = additive covariates (an intercept, at least)
+// boot_weights = matrix of weights (individuals x replicates); not the square-root
+// tol          = tolerance for dropping small eigenvalues in solving the
+//                normal equations
+//
+// output       = integer matrix (replicates x phenotypes) with the index
+//                (starting at 1) of the position with the maximum LOD score
+Rcpp::IntegerMatrix boot_peaks_hk_onechr(const Rcpp::NumericVector& genoprobs,
+                                         const Rcpp::NumericMatrix& pheno,
+                                         const Rcpp::NumericMatrix& addcovar,
+                                         const Rcpp::NumericMatrix& boot_weights,
+                                         const double tol);
+
+#endif // SCAN1BOOT_H
@@ -0,0 +1,114 @@
+// conditional genome scans, adding QTL as covariates one at a time
+//
+// The phenotypes and genotype probabilities are held as residuals
+// from the current set of covariates. Adding a QTL (with columns that
+// have already been residualized) then just requires projecting an
+// orthonormal basis for those few columns out of the residuals, with
+// no need to re-do the QR decomposition of the full covariate matrix.
+
+// [[Rcpp::depends(RcppEigen)]]
+
+#include "scan1cond.h"
+#include <RcppEigen.h>
+
+using namespace Rcpp;
+using namespace Eigen;
+
+// orthonormal basis for the column space of a matrix
+// (linearly dependent columns are dropped)
+//
+// X   = matrix (individuals x columns)
+// tol = tolerance for determining the rank
+//
+// output = matrix (individuals x rank) with orthonormal columns
+//
+// [[Rcpp::export]]
+NumericMatrix calc_orthobasis(const NumericMatrix& X, const double tol=1e-12)
+{
+    const MatrixXd XX(as<Map<MatrixXd> >(X));
+    const int n = XX.rows();
+
+    typedef Eigen::ColPivHouseholderQR<MatrixXd> CPivQR;
+
+    CPivQR PQR ( XX );
+    PQR.setThreshold(tol); // set tolerance
+    const int r = PQR.rank();
+
+    // first r columns of Q
+    MatrixXd Q = PQR.householderQ() * MatrixXd::Identity(n, r);
+
+    NumericMatrix result(wrap(Q));
+    return result;
+}
+
+// project the columns of an orthonormal basis out of a matrix:  Y - U (U'Y)
+//
+// U = matrix with orthonormal columns (individuals x k)
+// Y = matrix (individuals x columns)
+//
+// output = matrix (individuals x columns) of updated residuals
+//
+// [[Rcpp::export]]
+NumericMatrix project_out_matrix(const NumericMatrix& U, const NumericMatrix& Y)
+{
+    if(U.rows() != Y.rows())
+        throw std::range_error("nrow(U) != nrow(Y)");
+
+    const MatrixXd UU(as<Map<MatrixXd> >(U));
+    const MatrixXd YY(as<Map<MatrixXd> >(Y));
+
+    MatrixXd resid = YY - UU * (UU.transpose() * YY);
+
+    NumericMatrix result(wrap(resid));
+    result.attr("dimnames") = Y.attr("dimnames");
+
+    return result;
+}
+
+// project the columns of an orthonormal basis out of a 3d array
+//
+// U = matrix with orthonormal columns (individuals x k)
+// P = 3d array (individuals x genotypes x positions)
+// tol = columns whose norm is reduced by more than this factor are taken
+//       to be in the span of U and are set exactly to 0
+//
+// output = 3d array of updated residuals, same size as P
+//
+// [[Rcpp::export]]
+NumericVector project_out_3darray(const NumericMatrix& U, const NumericVector& P,
+                                  const double tol=1e-12)
+{
+    if(Rf_isNull(P.attr("dim")))
+        throw std::invalid_argument("P should be a 3d array but has no dim attribute");
+    const Dimension d = P.attr("dim");
+    if(d.size() != 3)
+        throw std::invalid_argument("P should be a 3d array");
+    const int n = d[0];
+    const int ncol = d[1]*d[2];
+    if(U.rows() != n)
+        throw std::range_error("nrow(U) != nrow(P)");
+
+    const MatrixXd UU(as<Map<MatrixXd> >(U));
+
+    // treat the array as an individuals x (genotypes*positions) matrix
+    const Map<const MatrixXd> PP(P.begin(), n, ncol);
+
+    NumericVector result(n*ncol);
+    Map<MatrixXd> resid(result.begin(), n, ncol);
+
+    // a single pass over the array: one product to get U'P, one to remove it
+    resid = PP - UU * (UU.transpose() * PP);
+
+    // columns that were in the span of U (e.g., the added QTL itself)
+    // are left with just round-off error; make them exactly 0 so they
+    // aren't fit in the scan
+    for(int j=0; j<ncol; j++) {
+        if(resid.col(j).norm() <= tol * PP.col(j).norm())
+            resid.col(j).setZero();
+    }
+
+    result.attr("dim") = d;
+    result.attr("dimnames") = P.attr("dimnames");
+
+    return result;
+}
@@ -0,0 +1,38 @@
+// conditional genome scans, adding QTL as covariates one at a time
+#ifndef SCAN1COND_H
+#define SCAN1COND_H
+
+#include <RcppEigen.h>
+
+// orthonormal basis for the column space of a matrix
+// (linearly dependent columns are dropped)
+//
+// X   = matrix (individuals x columns)
+// tol = tolerance for determining the rank
+//
+// output = matrix (individuals x rank) with orthonormal columns
+Rcpp::NumericMatrix calc_orthobasis(const Rcpp::NumericMatrix& X,
+                                    const double tol);
+
+// project the columns of an orthonormal basis out of a matrix:  Y - U (U'Y)
+//
+// U = matrix with orthonormal columns (individuals x k)
+// Y = matrix (individuals x columns)
+//
+// output = matrix (individuals x columns) of updated residuals
+Rcpp::NumericMatrix project_out_matrix(const Rcpp::NumericMatrix& U,
+                                       const Rcpp::NumericMatrix& Y);
+
+// project the columns of an orthonormal basis out of a 3d array
+//
+// U = matrix with orthonormal columns (individuals x k)
+// P = 3d array (individuals x genotypes x positions)
+// tol = columns whose norm is reduced by more than this factor are taken
+//       to be in the span of U and are set exactly to 0
+//
+// output = 3d array of updated residuals, same size as P
+Rcpp::NumericVector project_out_3darray(const Rcpp::NumericMatrix& U,
+                                        const Rcpp::NumericVector& P,
+                                        const double tol);
+
+#endif // SCAN1COND_H
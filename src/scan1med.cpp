@@ -0,0 +1,110 @@
+// mediation scan: QTL effect conditional on each of many candidate mediators
+//
+// Each mediator adds a single column to the null and alternative
+// models, so with orthonormal bases for the covariates (null) and the
+// covariates plus QTL (alternative), the residual sums of squares for
+// all mediators come from a few matrix products and inner products,
+// rather than a separate regression for each mediator.
+
+// [[Rcpp::depends(RcppEigen)]]
+
+#include "scan1med.h"
+#include <math.h>
+#include <RcppEigen.h>
+#include "scan1cond.h" // calc_orthobasis
+
+using namespace Rcpp;
+using namespace Eigen;
+
+// RSS from regressing a (residualized) outcome on a single (residualized) column
+// yy = |y|^2, xx = |x|^2, xy = x'y, xx_orig = |x|^2 before residualizing
+static inline double rss_onecol(const double yy, const double xx, const double xy,
+                                const double xx_orig, const double tol)
+{
+    if(xx <= tol * xx_orig) return yy; // x is in the span of the covariates
+    return yy - xy*xy/xx;
+}
+
+// LOD scores at a QTL, with and without conditioning on each mediator
+//
+// addcovar  = additive covariates (an intercept, at least)
+// genoprobs = matrix of genotype probabilities at the QTL (individuals x genotypes)
+// pheno     = vector of numeric phenotypes (individuals x 1)
+//             (no missing data allowed)
+// mediators = matrix of candidate mediators (individuals x mediators)
+//             (no missing data allowed)
+// reverse   = if true, the mediators are taken to be the outcomes and pheno
+//             is the covariate (mediator ~ QTL + pheno)
+// tol       = tolerance for linear regression by QR decomposition
+//
+// output    = matrix (mediators x 2) with LOD scores for the QTL without
+//             and with conditioning
+//
+// [[Rcpp::export]]
+NumericMatrix scan_mediators(const NumericMatrix& addcovar,
+                             const NumericMatrix& genoprobs,
+                             const NumericVector& pheno,
+                             const NumericMatrix& mediators,
+                             const bool reverse=false,
+                             const double tol=1e-12)
+{
+    const int n_ind = pheno.size();
+    const int n_med = mediators.cols();
+    if(n_ind != addcovar.rows())
+        throw std::range_error("length(pheno) != nrow(addcovar)");
+    if(n_ind != genoprobs.rows())
+        throw std::range_error("length(pheno) != nrow(genoprobs)");
+    if(n_ind != mediators.rows())
+        throw std::range_error("length(pheno) != nrow(mediators)");
+
+    const MatrixXd X(as<Map<MatrixXd> >(addcovar));
+    const MatrixXd G(as<Map<MatrixXd> >(genoprobs));
+    const VectorXd y(as<Map<VectorXd> >(pheno));
+    const MatrixXd M(as<Map<MatrixXd> >(mediators));
+
+    // orthonormal bases for the null (covariates) and alternative (covariates + QTL)
+    MatrixXd XG(n_ind, X.cols() + G.cols());
+    XG << X, G;
+    const MatrixXd Q0(as<Map<MatrixXd> >(calc_orthobasis(addcovar, tol)));
+    const MatrixXd Q1(as<Map<MatrixXd> >(calc_orthobasis(wrap(XG), tol)));
+
+    // residuals under each model
+    const VectorXd y0 = y - Q0 * (Q0.transpose() * y);
+    const VectorXd y1 = y - Q1 * (Q1.transpose() * y);
+    const MatrixXd M0 = M - Q0 * (Q0.transpose() * M);
+    const MatrixXd M1 = M - Q1 * (Q1.transpose() * M);
+
+    // inner products for all mediators at once
+    const double yy = y.squaredNorm();
+    const double yy0 = y0.squaredNorm();
+    const double yy1 = y1.squaredNorm();
+    const VectorXd mm = M.colwise().squaredNorm();
+    const VectorXd mm0 = M0.colwise().squaredNorm();
+    const VectorXd mm1 = M1.colwise().squaredNorm();
+    const VectorXd my0 = M0.transpose() * y0;
+    const VectorXd my1 = M1.transpose() * y1;
+
+    const double factor = (double)n_ind/2.0/log(10.0);
+    NumericMatrix result(n_med, 2);
+
+    for(int j=0; j<n_med; j++) {
+        double rss0, rss1;
+        if(reverse) { // mediator ~ covariates + pheno (+ QTL)
+            if(mm0[j] <= tol * mm[j]) { // mediator is explained by the covariates
+                result(j,0) = result(j,1) = 0.0;
+                continue;
+            }
+            result(j,0) = factor*(log(mm0[j]) - log(mm1[j]));
+            rss0 = rss_onecol(mm0[j], yy0, my0[j], yy, tol);
+            rss1 = rss_onecol(mm1[j], yy1, my1[j], yy, tol);
+        }
+        else { // pheno ~ covariates + mediator (+ QTL)
+            result(j,0) = factor*(log(yy0) - log(yy1));
+            rss0 = rss_onecol(yy0, mm0[j], my0[j], mm[j], tol);
+            rss1 = rss_onecol(yy1, mm1[j], my1[j], mm[j], tol);
+        }
+        result(j,1) = factor*(log(rss0) - log(rss1));
+    }
+
+    return result;
+}
@@ -0,0 +1,29 @@
+// mediation scan: QTL effect conditional on each of many candidate mediators
+#ifndef SCAN1MED_H
+#define SCAN1MED_H
+
+#include <RcppEigen.h>
+
+// LOD scores at a QTL, with and without conditioning on each mediator
+//
+// addcovar  = additive covariates (an intercept, at least)
+// genoprobs = matrix of genotype probabilities at the QTL (individuals x genotypes)
+// pheno     = vector of numeric phenotypes (individuals x 1)
+//             (no missing data allowed)
+// mediators = matrix of candidate mediators (individuals x mediators)
+//             (no missing data allowed)
+// reverse   = if true, the mediators are taken to be the outcomes and pheno
+//             is the covariate (mediator ~ QTL + pheno)
+// tol       = tolerance for linear regression by QR decomposition
+//
+// output    = matrix (mediators x 2) with LOD scores for the QTL without
+//             and with conditioning
+//
+Rcpp::NumericMatrix scan_mediators(const Rcpp::NumericMatrix& addcovar,
+                                   const Rcpp::NumericMatrix& genoprobs,
+                                   const Rcpp::NumericVector& pheno,
+                                   const Rcpp::NumericMatrix& mediators,
+                                   const bool reverse,
+                                   const double tol);
+
+#endif // SCAN1MED_H
@@ -0,0 +1,72 @@
+// genome scan by Haley-Knott regression with low-rank genotype probabilities
+//
+// Within a block of positions, the genotype probabilities are
+// approximated as U V_j, with U (individuals x rank) shared across the
+// block. The phenotypes are projected onto U once, and then each
+// position needs only genotypes x genotypes calculations.
+
+// [[Rcpp::depends(RcppEigen)]]
+
+#include "scan_hk_lowrank.h"
+#include <RcppEigen.h>
+
+using namespace Rcpp;
+using namespace Eigen;
+
+// residual sum of squares for HK regression at each position in a block
+// [[Rcpp::export(".scan_hk_lowrank")]]
+NumericMatrix scan_hk_lowrank(const NumericMatrix& U,
+                              const NumericVector& V,
+                              const NumericMatrix& pheno,
+                              const double tol)
+{
+    if(Rf_isNull(V.attr("dim")))
+        throw std::invalid_argument("V should be a 3d array but has no dim attribute");
+    const IntegerVector& dim = V.attr("dim");
+    if(dim.size() != 3)
+        throw std::invalid_argument("V should be a 3d array");
+    const int rank = dim[0];
+    const int n_gen = dim[1];
+    const int n_pos = dim[2];
+    const int n_ind = U.rows();
+    const int n_phe = pheno.cols();
+    if(U.cols() != rank)
+        throw std::invalid_argument("ncol(U) != dim(V)[1]");
+    if(pheno.rows() != n_ind)
+        throw std::invalid_argument("nrow(pheno) != nrow(U)");
+
+    const Map<MatrixXd> UU(as<Map<MatrixXd> >(U));
+    const Map<MatrixXd> Y(as<Map<MatrixXd> >(pheno));
+    const Map<const MatrixXd> VV(V.begin(), rank, n_gen*n_pos); // rank x (genotypes*positions)
+
+    // projections onto the block factors
+    const MatrixXd UtU = UU.transpose() * UU;
+    const MatrixXd UtY = UU.transpose() * Y;
+    const VectorXd rss0 = Y.colwise().squaredNorm().transpose();
+
+    NumericMatrix result(n_phe, n_pos);
+    for(int pos=0; pos<n_pos; pos++) {
+        Rcpp::checkUserInterrupt();  // check for ^C from user
+
+        const MatrixXd B = VV.block(0, pos*n_gen, rank, n_gen);
+        const MatrixXd XtX = B.transpose() * UtU * B;
+        const MatrixXd XtY = B.transpose() * UtY;
+
+        // fitted sum of squares, via eigen decomposition of X'X (which may be singular)
+        const SelfAdjointEigenSolver<MatrixXd> es(XtX);
+        const VectorXd& lambda = es.eigenvalues();
+        const double threshold = tol * std::max(lambda.maxCoeff(), 0.0);
+        const MatrixXd QtXtY = es.eigenvectors().transpose() * XtY;
+
+        for(int phe=0; phe<n_phe; phe++) {
+            double fitted = 0.0;
+            for(int k=0; k<n_gen; k++) {
+                if(lambda[k] > threshold && lambda[k] > 0.0)
+                    fitted += QtXtY(k,phe)*QtXtY(k,phe)/lambda[k];
+            }
+            result(phe,pos) = rss0[phe] - fitted;
+        }
+    }
+
+    return result;
+}
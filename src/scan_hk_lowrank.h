@@ -0,0 +1,21 @@
+// genome scan by Haley-Knott regression with low-rank genotype probabilities
+#ifndef SCAN_HK_LOWRANK_H
+#define SCAN_HK_LOWRANK_H
+
+#include <Rcpp.h>
+
+// residual sum of squares for HK regression at each position in a block,
+// with the genotype probabilities at position j approximated by U V_j
+//
+// U     = individuals x rank matrix of block factors, with covariates projected out
+// V     = rank x genotypes x positions array of loadings
+// pheno = individuals x phenotypes matrix, with covariates projected out
+// tol   = tolerance for linear dependence
+//
+// output = phenotypes x positions matrix of RSS
+Rcpp::NumericMatrix scan_hk_lowrank(const Rcpp::NumericMatrix& U,
+                                    const Rcpp::NumericVector& V,
+                                    const Rcpp::NumericMatrix& pheno,
+                                    const double tol);
+
+#endif // SCAN_HK_LOWRANK_H
@@ -0,0 +1,243 @@
+// vector kernels, with versions for different instruction sets chosen at run time
+//
+// The package is compiled for a generic baseline (e.g., SSE2 on x86-64).
+// With GCC or clang on x86, the kernels are also compiled for AVX2 (with FMA)
+// and AVX-512, using function target attributes, and the best version that
+// the CPU supports is used.
+
+#include "simd_kernels.h"
+#include <string>
+#include <Rcpp.h>
+using namespace Rcpp;
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define QTL2_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+// generic versions
+static double dot_generic(const double* x, const double* y, const int n)
+{
+    double result = 0.0;
+    for(int i=0; i<n; i++) result += x[i]*y[i];
+    return result;
+}
+
+static void mult_generic(const double* x, const double* w, double* result, const int n)
+{
+    for(int i=0; i<n; i++) result[i] = x[i]*w[i];
+}
+
+static void add_generic(const double* x, double* result, const int n)
+{
+    for(int i=0; i<n; i++) result[i] += x[i];
+}
+
+static void add_mean_generic(const double* x, const double* y, double* result, const int n)
+{
+    for(int i=0; i<n; i++) result[i] += (x[i] + y[i])/2.0;
+}
+
+#ifdef QTL2_X86_DISPATCH
+
+// AVX2 versions (the dot product also uses FMA)
+__attribute__((target("avx2,fma")))
+static double dot_avx2(const double* x, const double* y, const int n)
+{
+    __m256d sum0 = _mm256_setzero_pd(), sum1 = _mm256_setzero_pd();
+    int i=0;
+    for(; i+8<=n; i+=8) {
+        sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(x+i), _mm256_loadu_pd(y+i), sum0);
+        sum1 = _mm256_fmadd_pd(_mm256_loadu_pd(x+i+4), _mm256_loadu_pd(y+i+4), sum1);
+    }
+    for(; i+4<=n; i+=4)
+        sum0 = _mm256_fmadd_pd(_mm256_loadu_pd(x+i), _mm256_loadu_pd(y+i), sum0);
+
+    double part[4];
+    _mm256_storeu_pd(part, _mm256_add_pd(sum0, sum1));
+    double result = (part[0] + part[1]) + (part[2] + part[3]);
+    for(; i<n; i++) result += x[i]*y[i];
+    return result;
+}
+
+__attribute__((target("avx2")))
+static void mult_avx2(const double* x, const double* w, double* result, const int n)
+{
+    int i=0;
+    for(; i+4<=n; i+=4)
+        _mm256_storeu_pd(result+i, _mm256_mul_pd(_mm256_loadu_pd(x+i), _mm256_loadu_pd(w+i)));
+    for(; i<n; i++) result[i] = x[i]*w[i];
+}
+
+__attribute__((target("avx2")))
+static void add_avx2(const double* x, double* result, const int n)
+{
+    int i=0;
+    for(; i+4<=n; i+=4)
+        _mm256_storeu_pd(result+i, _mm256_add_pd(_mm256_loadu_pd(result+i), _mm256_loadu_pd(x+i)));
+    for(; i<n; i++) result[i] += x[i];
+}
+
+__attribute__((target("avx2")))
+static void add_mean_avx2(const double* x, const double* y, double* result, const int n)
+{
+    const __m256d half = _mm256_set1_pd(0.5);
+    int i=0;
+    for(; i+4<=n; i+=4) {
+        const __m256d mean = _mm256_mul_pd(_mm256_add_pd(_mm256_loadu_pd(x+i), _mm256_loadu_pd(y+i)), half);
+        _mm256_storeu_pd(result+i, _mm256_add_pd(_mm256_loadu_pd(result+i), mean));
+    }
+    for(; i<n; i++) result[i] += (x[i] + y[i])/2.0;
+}
+
+// AVX-512 versions
+__attribute__((target("avx512f")))
+static double dot_avx512(const double* x, const double* y, const int n)
+{
+    __m512d sum0 = _mm512_setzero_pd(), sum1 = _mm512_setzero_pd();
+    int i=0;
+    for(; i+16<=n; i+=16) {
+        sum0 = _mm512_fmadd_pd(_mm512_loadu_pd(x+i), _mm512_loadu_pd(y+i), sum0);
+        sum1 = _mm512_fmadd_pd(_mm512_loadu_pd(x+i+8), _mm512_loadu_pd(y+i+8), sum1);
+    }
+    for(; i+8<=n; i+=8)
+        sum0 = _mm512_fmadd_pd(_mm512_loadu_pd(x+i), _mm512_loadu_pd(y+i), sum0);
+
+    double part[8];
+    _mm512_storeu_pd(part, _mm512_add_pd(sum0, sum1));
+    double result = ((part[0] + part[1]) + (part[2] + part[3])) +
+        ((part[4] + part[5]) + (part[6] + part[7]));
+    for(; i<n; i++) result += x[i]*y[i];
+    return result;
+}
+
+__attribute__((target("avx512f")))
+static void mult_avx512(const double* x, const double* w, double* result, const int n)
+{
+    int i=0;
+    for(; i+8<=n; i+=8)
+        _mm512_storeu_pd(result+i, _mm512_mul_pd(_mm512_loadu_pd(x+i), _mm512_loadu_pd(w+i)));
+    for(; i<n; i++) result[i] = x[i]*w[i];
+}
+
+__attribute__((target("avx512f")))
+static void add_avx512(const double* x, double* result, const int n)
+{
+    int i=0;
+    for(; i+8<=n; i+=8)
+        _mm512_storeu_pd(result+i, _mm512_add_pd(_mm512_loadu_pd(result+i), _mm512_loadu_pd(x+i)));
+    for(; i<n; i++) result[i] += x[i];
+}
+
+__attribute__((target("avx512f")))
+static void add_mean_avx512(const double* x, const double* y, double* result, const int n)
+{
+    const __m512d half = _mm512_set1_pd(0.5);
+    int i=0;
+    for(; i+8<=n; i+=8) {
+        const __m512d mean = _mm512_mul_pd(_mm512_add_pd(_mm512_loadu_pd(x+i), _mm512_loadu_pd(y+i)), half);
+        _mm512_storeu_pd(result+i, _mm512_add_pd(_mm512_loadu_pd(result+i), mean));
+    }
+    for(; i<n; i++) result[i] += (x[i] + y[i])/2.0;
+}
+
+#endif // QTL2_X86_DISPATCH
+
+// a set of kernels
+struct KernelSet {
+    const char* name;
+    double (*dot)(const double*, const double*, const int);
+    void (*mult)(const double*, const double*, double*, const int);
+    void (*add)(const double*, double*, const int);
+    void (*add_mean)(const double*, const double*, double*, const int);
+};
+
+static const KernelSet kernel_sets[] = {
+    {"generic", dot_generic, mult_generic, add_generic, add_mean_generic}
+#ifdef QTL2_X86_DISPATCH
+    , {"avx2", dot_avx2, mult_avx2, add_avx2, add_mean_avx2}
+    , {"avx512", dot_avx512, mult_avx512, add_avx512, add_mean_avx512}
+#endif
+};
+static const int n_kernel_sets = sizeof(kernel_sets)/sizeof(KernelSet);
+
+// whether the CPU supports a set of kernels
+static bool kernels_supported(const int k)
+{
+#ifdef QTL2_X86_DISPATCH
+    __builtin_cpu_init();
+    const std::string name = kernel_sets[k].name;
+    if(name == "avx2")
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    if(name == "avx512")
+        return __builtin_cpu_supports("avx512f");
+#endif
+    return true;
+}
+
+// the set of kernels in use; chosen on first use
+static const KernelSet* kernels = NULL;
+
+static const KernelSet* best_kernels()
+{
+    for(int k=n_kernel_sets-1; k>0; k--)
+        if(kernels_supported(k)) return &kernel_sets[k];
+    return &kernel_sets[0];
+}
+
+static inline const KernelSet* get_kernels()
+{
+    if(kernels == NULL) kernels = best_kernels();
+    return kernels;
+}
+
+double simd_dot(const double* x, const double* y, const int n)
+{
+    return get_kernels()->dot(x, y, n);
+}
+
+void simd_mult(const double* x, const double* w, double* result, const int n)
+{
+    get_kernels()->mult(x, w, result, n);
+}
+
+void simd_add(const double* x, double* result, const int n)
+{
+    get_kernels()->add(x, result, n);
+}
+
+void simd_add_mean(const double* x, const double* y, double* result, const int n)
+{
+    get_kernels()->add_mean(x, y, result, n);
+}
+
+// set of kernels in use
+// [[Rcpp::export(".simd_level")]]
+std::string simd_level(const std::string& level)
+{
+    if(level == "auto") {
+        kernels = best_kernels();
+    }
+    else if(level != "") {
+        int k=0;
+        while(k < n_kernel_sets && level != kernel_sets[k].name) k++;
+        if(k == n_kernel_sets)
+            throw std::invalid_argument("kernels \"" + level + "\" not available in this build");
+        if(!kernels_supported(k))
+            throw std::invalid_argument("kernels \"" + level + "\" not supported by this CPU");
+        kernels = &kernel_sets[k];
+    }
+
+    return get_kernels()->name;
+}
+
+// sets of kernels that the CPU supports
+// [[Rcpp::export(".simd_available")]]
+CharacterVector simd_available()
+{
+    std::vector<std::string> result;
+    for(int k=0; k<n_kernel_sets; k++)
+        if(kernels_supported(k)) result.push_back(kernel_sets[k].name);
+
+    return wrap(result);
+}
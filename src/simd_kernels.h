@@ -0,0 +1,31 @@
+// vector kernels, with versions for different instruction sets chosen at run time
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <Rcpp.h>
+
+// dot product, sum_i x[i]*y[i]
+double simd_dot(const double* x, const double* y, const int n);
+
+// elementwise product, result[i] = x[i]*w[i]
+void simd_mult(const double* x, const double* w, double* result, const int n);
+
+// add to a vector, result[i] += x[i]
+void simd_add(const double* x, double* result, const int n);
+
+// add the average of two vectors, result[i] += (x[i] + y[i])/2
+void simd_add_mean(const double* x, const double* y, double* result, const int n);
+
+// set of kernels in use
+//
+// level = "generic", "avx2", or "avx512" to select a set of kernels,
+//         "auto" for the best one that the CPU supports,
+//         or "" to leave it unchanged
+//
+// output = name of the set of kernels in use
+std::string simd_level(const std::string& level);
+
+// sets of kernels that the CPU supports
+Rcpp::CharacterVector simd_available();
+
+#endif // SIMD_KERNELS_H
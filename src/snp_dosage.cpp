@@ -0,0 +1,122 @@
+// SNP dosages from genotype/allele probabilities, as fixed-point codes
+
+#include "snp_dosage.h"
+#include <exception>
+#include <map>
+#include <utility>
+#include <math.h>
+#include <Rcpp.h>
+#include "snpprobs.h"
+using namespace Rcpp;
+
+// dosage (expected number of B alleles) for each genotype column
+//
+// [[Rcpp::export]]
+NumericVector genocol_to_dosage(const int n_str, const int n_gen, const int sdp)
+{
+    if(sdp < 1 || sdp > (1 << n_str)-1)
+        throw std::invalid_argument("SDP out of range");
+
+    NumericVector result(n_gen);
+
+    if(n_gen == n_str) { // allele probabilities
+        for(int str=0; str<n_str; str++)
+            result[str] = ((sdp & (1 << str)) != 0) ? 2.0 : 0.0;
+    }
+    else if(n_gen == n_str*(n_str+1)/2) { // autosomal genotypes
+        IntegerVector snpcol = genocol_to_snpcol(n_str, sdp);
+        for(int g=0; g<n_gen; g++) result[g] = snpcol[g];
+    }
+    else if(n_gen == n_str + n_str*(n_str+1)/2) { // X chr genotypes
+        IntegerVector snpcol = Xgenocol_to_snpcol(n_str, sdp);
+        for(int g=0; g<n_gen; g++) {
+            if(snpcol[g] == 3) result[g] = 0.0;      // AY
+            else if(snpcol[g] == 4) result[g] = 2.0; // BY
+            else result[g] = snpcol[g];
+        }
+    }
+    else throw std::invalid_argument("n_gen doesn't conform to n_str");
+
+    return result;
+}
+
+// convert genotype or allele probabilities to SNP dosages, as fixed-point codes
+//
+// [[Rcpp::export]]
+IntegerMatrix snp_dosage_fixedpoint(const NumericVector& genoprob,
+                                    const int n_str,
+                                    const IntegerVector& sdp,
+                                    const IntegerVector& interval,
+                                    const LogicalVector& on_map,
+                                    const int bits)
+{
+    if(Rf_isNull(genoprob.attr("dim")))
+        throw std::invalid_argument("genoprob should be a 3d array but has no dim attribute");
+    const IntegerVector& d = genoprob.attr("dim");
+    if(d.size() != 3)
+        throw std::invalid_argument("genoprob should be a 3d array");
+    const int n_ind = d[0];
+    const int n_gen = d[1];
+    const int n_pos = d[2];
+    const int n_snp = sdp.size();
+    if(n_snp != interval.size())
+        throw std::invalid_argument("length(sdp) != length(interval)");
+    if(n_snp != on_map.size())
+        throw std::invalid_argument("length(sdp) != length(on_map)");
+    if(bits != 8 && bits != 16)
+        throw std::invalid_argument("bits should be 8 or 16");
+
+    const int na_code = (1 << bits) - 1;
+    const double scale = (double)(na_code - 1)/2.0;
+
+    // check that the interval and SDP values are okay
+    for(int i=0; i<n_snp; i++) {
+        if(interval[i] < 0 || interval[i] > n_pos-1 ||
+           (interval[i] == n_pos-1 && !on_map[i]))
+            throw std::invalid_argument("snp outside of map range");
+        if(sdp[i] < 1 || sdp[i] > (1 << n_str)-1)
+            throw std::invalid_argument("SDP out of range");
+    }
+
+    IntegerMatrix result(n_ind, n_snp);
+
+    // SNPs with the same (interval, on_map, sdp) pattern have the same dosages
+    std::map<std::pair<int,int>, int> first_snp;
+
+    for(int snp=0; snp<n_snp; snp++) {
+        Rcpp::checkUserInterrupt();  // check for ^C from user
+
+        std::pair<int,int> pattern = std::make_pair(interval[snp]*2 + (on_map[snp] ? 1 : 0), sdp[snp]);
+        std::map<std::pair<int,int>, int>::iterator it = first_snp.find(pattern);
+        if(it != first_snp.end()) {
+            for(int ind=0; ind<n_ind; ind++)
+                result(ind, snp) = result(ind, it->second);
+            continue;
+        }
+        first_snp[pattern] = snp;
+
+        NumericVector wts = genocol_to_dosage(n_str, n_gen, sdp[snp]);
+
+        for(int ind=0; ind<n_ind; ind++) {
+            double dosage = 0.0;
+            for(int g=0; g<n_gen; g++) {
+                if(wts[g] == 0.0) continue;
+                int input_offset = ind + g*n_ind + interval[snp]*n_ind*n_gen;
+                if(on_map[snp])
+                    dosage += wts[g] * genoprob[input_offset];
+                else
+                    dosage += wts[g] * (genoprob[input_offset] + genoprob[input_offset + n_ind*n_gen])/2.0;
+            }
+
+            if(ISNAN(dosage)) result(ind, snp) = na_code;
+            else {
+                int code = (int)round(dosage * scale);
+                if(code < 0) code = 0;
+                if(code > na_code - 1) code = na_code - 1;
+                result(ind, snp) = code;
+            }
+        }
+    }
+
+    return result;
+}
@@ -0,0 +1,36 @@
+// SNP dosages from genotype/allele probabilities, as fixed-point codes
+#ifndef SNP_DOSAGE_H
+#define SNP_DOSAGE_H
+
+#include <Rcpp.h>
+
+// dosage (expected number of B alleles) for each genotype column
+//
+// n_str     Number of strains
+// n_gen     Number of genotype columns (n_str for allele probabilities,
+//           n_str*(n_str+1)/2 for autosomal genotypes, or
+//           n_str + n_str*(n_str+1)/2 for X chr genotypes)
+// sdp       Strain distribution pattern for SNP
+//
+// Male X chr hemizygotes are treated as homozygous (dosage 0 or 2).
+Rcpp::NumericVector genocol_to_dosage(const int n_str, const int n_gen, const int sdp);
+
+// convert genotype or allele probabilities to SNP dosages, as fixed-point codes
+//
+// genoprob = individual x genotype x position
+// n_str    = number of strains
+// sdp      = vector of strain distribution patterns
+// interval = map interval containing snp
+// on_map   = logical vector indicating snp is at left endpoint of interval
+// bits     = number of bits per value (8 or 16)
+//
+// output   = matrix of codes (individuals x snps), with dosage in [0,2]
+//            scaled to [0, 2^bits - 2]; 2^bits - 1 indicates a missing value
+Rcpp::IntegerMatrix snp_dosage_fixedpoint(const Rcpp::NumericVector& genoprob,
+                                          const int n_str,
+                                          const Rcpp::IntegerVector& sdp,
+                                          const Rcpp::IntegerVector& interval,
+                                          const Rcpp::LogicalVector& on_map,
+                                          const int bits);
+
+#endif // SNP_DOSAGE_H
@@ -3,6 +3,7 @@
 #include "snpprobs.h"
 #include <exception>
 #include <Rcpp.h>
+#include "simd_kernels.h"
 using namespace Rcpp;
 
 
@@ -107,15 +108,11 @@ NumericVector alleleprob_to_snpprob(const NumericVector& alleleprob,
             int result_offset = allele*n_ind + (snp*n_ind*2);
             int input_offset = strain*n_ind + (interval[snp]*n_ind*n_str);
             int next_on_map = input_offset + n_ind*n_str;
-            for(int ind=0; ind<n_ind; ind++) {
-                if(on_map[snp]) {
-                    result[ind + result_offset] += alleleprob[ind + input_offset];
-                }
-                else {
-                    result[ind + result_offset] += (alleleprob[ind + input_offset] +
-                                                    alleleprob[ind + next_on_map])/2.0;
-                }
-            } // loop over individuals
+            if(on_map[snp])
+                simd_add(alleleprob.begin() + input_offset, result.begin() + result_offset, n_ind);
+            else
+                simd_add_mean(alleleprob.begin() + input_offset, alleleprob.begin() + next_on_map,
+                              result.begin() + result_offset, n_ind);
         }
     } // loop over snps
 
@@ -212,15 +209,11 @@ NumericVector genoprob_to_snpprob(const NumericVector& genoprob,
             int result_offset = snpcol[g]*n_ind + (snp*n_ind*3);
             int input_offset = g*n_ind + (interval[snp]*n_ind*n_gen);
             int next_on_map = input_offset + n_ind*n_gen;
-            for(int ind=0; ind<n_ind; ind++) {
-                if(on_map[snp]) {
-                    result[ind + result_offset] += genoprob[ind + input_offset];
-                }
-                else {
-                    result[ind + result_offset] += (genoprob[ind + input_offset] +
-                                                    genoprob[ind + next_on_map])/2.0;
-                }
-            } // loop over individuals
+            if(on_map[snp])
+                simd_add(genoprob.begin() + input_offset, result.begin() + result_offset, n_ind);
+            else
+                simd_add_mean(genoprob.begin() + input_offset, genoprob.begin() + next_on_map,
+                              result.begin() + result_offset, n_ind);
         }
     } // loop over snps
 
@@ -324,15 +317,11 @@ NumericVector Xgenoprob_to_snpprob(const NumericVector& genoprob,
             int result_offset = snpcol[g]*n_ind + (snp*n_ind*5);
             int input_offset = g*n_ind + (interval[snp]*n_ind*n_gen);
             int next_on_map = input_offset + n_ind*n_gen;
-            for(int ind=0; ind<n_ind; ind++) {
-                if(on_map[snp]) {
-                    result[ind + result_offset] += genoprob[ind + input_offset];
-                }
-                else {
-                    result[ind + result_offset] += (genoprob[ind + input_offset] +
-                                                    genoprob[ind + next_on_map])/2.0;
-                }
-            } // loop over individuals
+            if(on_map[snp])
+                simd_add(genoprob.begin() + input_offset, result.begin() + result_offset, n_ind);
+            else
+                simd_add_mean(genoprob.begin() + input_offset, genoprob.begin() + next_on_map,
+                              result.begin() + result_offset, n_ind);
         }
     } // loop over snps
 
@@ -57,7 +57,7 @@ Rcpp::NumericVector genoprob_to_snpprob(const Rcpp::NumericVector& genoprob,
 // n_str     Number of strains
 //    (so n_str + n_str*(n_str+1)/2 columns)
 // sdp       Strain distribution pattern for SNP
-Rcpp::IntegerVector genocol_to_snpcol(const int n_str, const int sdp);
+Rcpp::IntegerVector Xgenocol_to_snpcol(const int n_str, const int sdp);
 
 // convert X chr genotype probabilities into SNP probabilities
 //